@@ -0,0 +1,31 @@
+
+/*!
+ * \file allocation.cpp
+ * \brief the global operator new/delete counting the allocations (see
+ *        allocation.hpp), debug builds only
+ */
+
+#include "include/utils/allocation.hpp"
+#include <cstdlib>
+#include <new>
+
+#if !defined(NDEBUG)
+
+void* operator new(std::size_t size) {
+    xtd::allocations::counter().fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif // NDEBUG
@@ -0,0 +1,178 @@
+
+/*!
+ * \file auto_shift.hpp
+ * \brief delayed auto shift (DAS) and auto repeat (ARR) of the left and right
+ *        moves, on the game's clock instead of the terminal's key repeat
+ */
+
+#if !defined (_AUTO_SHIFT_H_)
+#define _AUTO_SHIFT_H_
+
+#include "engine.h"
+#include <limits>
+
+///
+/// \brief moves the block while a left or right key is held
+///
+/// A press moves the block one column. If the key is still held das ticks
+/// later the block moves again, then every arr ticks; with arr 0 it goes to
+/// the wall at once (and a new block too, while the key is held). The last
+/// direction pressed wins, releasing it gives the move back to the other
+/// one if it is still held.
+///
+/// A backend without key releases (a terminal) sends the key again and again
+/// while it is held: such a press only tells that the key is still held, and
+/// the key counts as released release ticks after its last press.
+///
+struct auto_shift {
+    enum class direction {
+        left,
+        right
+    };
+
+private:
+    ///
+    /// \brief held_ true between the press and the release
+    ///         ticks_ ticks since the press
+    ///         idle_ ticks since the last press (or repeat) of the key
+    ///
+    struct key {
+        bool held_;
+        int ticks_;
+        int idle_;
+    };
+
+///
+/// \brief das_, arr_ delay and repeat rate of the moves, in ticks
+///         release_ ticks without a press after which a key is released
+///             (0 if the backend reports the releases)
+///         keys_ left and right
+///         active_ the direction that moves, if any is held
+///         repeat_ ticks since the last move by repeat
+///
+    int das_;
+    int arr_;
+    int release_;
+    key keys_[2];
+    direction active_;
+    int repeat_;
+
+public:
+    static constexpr int never = std::numeric_limits<int>::max();
+
+    auto_shift() = delete;
+
+    auto_shift(int das, int arr, int release = 0) :
+        das_(das),
+        arr_(arr),
+        release_(release),
+        keys_{ { false, 0, 0 }, { false, 0, 0 } },
+        active_(direction::left),
+        repeat_(0)
+    {
+    }
+
+    int das() const noexcept {
+        return das_;
+    }
+
+    int arr() const noexcept {
+        return arr_;
+    }
+
+    ///
+    /// \brief the key of direction d is pressed (or repeated by the backend)
+    ///
+    void press(direction d, engine& eng) {
+        key& k = keys_[index(d)];
+        k.idle_ = 0;
+        if (k.held_) {
+            return;
+        }
+
+        k.held_ = true;
+        k.ticks_ = 0;
+        active_ = d;
+        repeat_ = 0;
+        eng.shift(step(d));
+    }
+
+    void release(direction d) noexcept {
+        keys_[index(d)].held_ = false;
+        if (d == active_) {
+            active_ = other(d);
+            repeat_ = 0;
+        }
+    }
+
+    ///
+    /// \brief advances the held keys by one tick and moves the block
+    ///
+    void tick(engine& eng) {
+        for (auto i = 0u; i < 2; ++i) {
+            key& k = keys_[i];
+            if (k.held_ && release_ > 0 && ++k.idle_ >= release_) {
+                release(static_cast<direction>(i));
+            }
+        }
+
+        key& k = keys_[index(active_)];
+        if (!k.held_) {
+            return;
+        }
+
+        if (k.ticks_ < das_) {
+            if (++k.ticks_ < das_) {
+                return;
+            }
+            // charged, moves now
+            repeat_ = arr_;
+        }
+
+        if (0 == arr_) {
+            eng.shift(step(active_) * static_cast<int>(eng.board_width()));
+        }
+        else if (++repeat_ >= arr_) {
+            repeat_ = 0;
+            eng.shift(step(active_));
+        }
+    }
+
+    ///
+    /// \brief the number of ticks until tick() moves the block or releases a
+    ///         key, never if nothing is held (or the block is at the wall)
+    ///
+    int idle_ticks(engine const& eng) const noexcept {
+        int ticks = never;
+        if (release_ > 0) {
+            for (auto const& k : keys_) {
+                if (k.held_ && release_ - k.idle_ < ticks) {
+                    ticks = release_ - k.idle_;
+                }
+            }
+        }
+
+        key const& k = keys_[index(active_)];
+        if (k.held_ && 0 != eng.reach(step(active_))) {
+            int move = (k.ticks_ < das_) ? das_ - k.ticks_ : ((0 == arr_) ? 1 : arr_ - repeat_);
+            ticks = (move < ticks) ? move : ticks;
+        }
+
+        return (ticks > 0) ? ticks : 1;
+    }
+
+private:
+    static unsigned index(direction d) noexcept {
+        return (direction::left == d) ? 0 : 1;
+    }
+
+    static direction other(direction d) noexcept {
+        return (direction::left == d) ? direction::right : direction::left;
+    }
+
+    static int step(direction d) noexcept {
+        return (direction::left == d) ? -1 : 1;
+    }
+};
+
+#endif // _AUTO_SHIFT_H_
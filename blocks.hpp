@@ -8,36 +8,34 @@
 #define _BLOCKS_H_
 
 #include "board.hpp"
+#include "pieces.hpp"
 
 using namespace xtd;
-#if defined(OS_LINUX)
-using console_type = console;
-#elif defined(OS_WIN)
-using console_type = xtd::console<xtd::screen_buffered<wchar_t>>;
-#endif
 
 ///
-/// \brief class used to create tetromino blocks
+/// \brief class used to create tetromino blocks, a (piece, rotation, position)
+///         value; the shape itself comes from the compile time pieces table
 ///
 struct block {
-    using matrix_type = matrix<cell>;
-    using line_type = matrix_type::line_type;
-    using size_type = matrix_type::size_type;
-    using string_type = std::string;
+    using size_type = std::size_t;
+    using row_type = board::row_type;
    
 
 ///
-/// \brief cells_ used to make tetromino block using cell
+/// \brief piece_ the tetromino kind, used to select its shape and color
+///         rotation_ index of the shape in the pieces table
 ///         pos_ used to adjust block's position on board/in console
 ///
 private:
-    matrix_type cells_;
+    piece piece_;
+    unsigned char rotation_;
     coord_type pos_;
 
 public:
     block() = delete;
-    block(size_type rows, size_type columns, coord_type pos) :
-        cells_(rows, columns),
+    block(piece p, coord_type pos) :
+        piece_(p),
+        rotation_(0),
         pos_(pos)
     {
 
@@ -50,26 +48,18 @@ public:
     block(block&&) = default;
     block& operator= (block&&) = default;
 
-    line_type& operator[](size_type i) {
-        return cells_[i];
-    }
-
-    line_type const& operator[](size_type i) const {
-        return cells_[i];
-    }
-
     ///
     /// \brief get block width
     ///
     size_type width() const noexcept {
-        return cells_.columns();
+        return piece_table::size;
     }
 
     ///
     /// \brief get block height
     ///
     size_type height() const noexcept {
-        return cells_.rows();
+        return piece_table::size;
     }
 
     ///
@@ -79,6 +69,42 @@ public:
         return pos_;
     }   
 
+    ///
+    /// \brief get the tetromino kind
+    ///
+    piece type() const noexcept {
+        return piece_;
+    }
+
+    ///
+    /// \brief get the rotation index
+    ///
+    size_type rotation() const noexcept {
+        return rotation_;
+    }
+
+    ///
+    /// \brief get the block's current shape
+    ///
+    shape const& get_shape() const noexcept {
+        return pieces(piece_, rotation_);
+    }
+
+    ///
+    /// \brief get the block's shape, i.e. the state of its cells
+    ///
+    state kind() const noexcept {
+        return piece_state(piece_);
+    }
+
+    ///
+    /// \brief get the occupancy mask of block row y, bit x set if
+    ///         the cell in column x is not empty
+    ///
+    row_type mask(size_type y) const noexcept {
+        return get_shape().row(y);
+    }
+
     ///
     /// \brief set block position
     ///
@@ -87,36 +113,18 @@ public:
     }
 
     ///
-    /// \brief change the state of each cell based on it's shape
-    ///         in order to set different colors for each block
-    ///
-    void init(string_type string) {
-        for (auto i = 0u; i < string.length(); ++i) {
-            if (string[i] == 'I') {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::I;
-            }
-            else if (string[i] == 'O') {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::O;
-            }
-            else if (string[i] == 'T') {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::T;
-            }
-            else if (string[i] == 'L') {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::L;
-            }
-            else if (string[i] == 'J') {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::J;
-            }
-            else if (string[i] == 'S') {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::S;
-            }
-            else if (string[i] == 'Z') {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::Z;
-            }
-            else {
-                cells_[i / cells_.rows()][i % cells_.columns()].state_ = state::empty;
-            }
-        }
+    /// \brief set the rotation index
+    ///
+    void set_rotation(size_type rotation) {
+        rotation_ = static_cast<unsigned char>(rotation % piece_table::rotations);
+    }
+
+    ///
+    /// \brief changes the block's piece, back in its spawn rotation
+    ///
+    void init(piece p) {
+        piece_ = p;
+        rotation_ = 0;
     }
     
     ///
@@ -138,87 +146,12 @@ public:
         --pos_.Y;
     }
 
-    //void rotate_block_left(block& b) {
-    //    for (unsigned long x = 0; x < b.height_block() / 2; ++x) {
-    //        for (unsigned long y = x; y < b.height_block() - x - 1; y++) {
-    //            auto tmp = b[x][y];
-    //            b[x][y] = b[y][b.height_block() - 1 - x];
-    //            b[y][b.height_block() - 1 - x] = b[b.height_block() - 1 - x][b.height_block() - 1 - y];
-    //            b[b.height_block() - 1 - x][b.height_block() - 1 - y] = b[b.height_block() - 1 - y][x];
-    //            b[b.height_block() - 1 - y][x] = tmp;
-    //        }
-    //    }
-    //}
-
-
     ///
-    /// \brief goes through each cell and changes its position
-    ///         within the block, thus changing the pattern of the block,
-    ///         simulating a clockwise rotation
+    /// \brief selects the next shape in the table, simulating
+    ///         a clockwise rotation
     ///
     void rotate_right() {
-        for (auto x = 0u; x < height() / 2; ++x) {
-            for (auto y = x; y < height() - x - 1; ++y) {
-                auto tmp = cells_[x][y];
-                cells_[x][y] = cells_[height() - 1 - y][x];
-                cells_[height() - 1 - y][x] = cells_[height() - 1 - x][height() - 1 - y];
-                cells_[height() - 1 - x][height() - 1 - y] = cells_[y][height() - 1 - x];
-                cells_[y][height() - 1 - x] = tmp;
-            }
-        }
-    }
-
-    ///
-    /// \brief used to print the block in the console and assign
-    ///         a different color based on its shape/cell state
-    ///
-    void print(console_type& con, coord_type orig) {
-        for (auto x = 0u; x < cells_.columns(); ++x) {
-            for (auto y = 0u; y < cells_.rows(); ++y) {
-                cell const& c = cells_[y][x];
-                bool color = true;
-                switch (c.state_) {
-                case state::I:
-                    con.set_attr(1);
-                    break;
-                case state::O:
-                    con.set_attr(2);
-                    break;
-                case state::T:
-                    con.set_attr(3);
-                    break;
-                case state::L:
-                    con.set_attr(4);
-                    break;
-                case state::J:
-                    con.set_attr(5);
-                    break;
-                case state::S:
-                    con.set_attr(6);
-                    break;
-                case state::Z:
-                    con.set_attr(7);
-                    break;
-
-                default:
-                    color = false;
-                    ;
-
-                }
-
-                ///
-                /// \brief this moves the console's coursor at a certail position
-                ///         in order to print the block there
-                ///
-                if (color) {
-                    con.move_cursor(make_coord(orig.X + (pos_.X + x) * 2, orig.Y + (pos_.Y - 1) + y));
-                    con.print(' ');
-                    con.refresh();
-                    con.print(' ');
-                    con.refresh();
-                }
-            }
-        }
+        rotation_ = (rotation_ + 1) % piece_table::rotations;
     }
 }; // struct block
 
@@ -9,16 +9,13 @@
 
 #include "cell.h"
 #include "matrix.hpp"
-#include "console/console.hpp"
 #include "console/types.hpp"
-#include "console/gdi.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <cassert>
 
 using namespace xtd;
-#if defined(OS_LINUX)
-using console_type = console;
-#elif defined(OS_WIN)
-using console_type = xtd::console<xtd::screen_buffered<wchar_t>>;
-#endif
 
 
 ///
@@ -27,14 +24,49 @@ using console_type = xtd::console<xtd::screen_buffered<wchar_t>>;
 struct board {
     using matrix_type = matrix<cell>;
     using line_type = matrix_type::line_type;
+    using const_line_type = matrix_type::const_line_type;
     using size_type = matrix_type::size_type;
+    // one bit per column, bit x set if column x is occupied
+    using row_type = std::uint32_t;
+    using rows_type = std::vector<row_type>;
+    using slots_type = std::vector<size_type>;
+
+    ///
+    /// \brief consecutive cells of a row in the same state
+    ///
+    struct run {
+        state state_ = state::empty;
+        size_type length_ = 0;
+    };
+    using runs_type = matrix<run>;
+    using const_runs_type = runs_type::const_line_type;
+
+    ///
+    /// \brief widest board the row masks can hold; a 4 cells wide piece
+    ///         shifted against the right wall must still fit in a row_type
+    ///
+    static constexpr size_type max_width = sizeof(row_type) * 8 - 3;
 
 ///
 /// \brief cells_ used to make block using class cell
+///         (only the color plane, used for rendering)
+///         rows_ occupancy bitboard used for collisions, the walls and
+///         the columns past the right wall are always set
+///         slots_ maps each board row to the cells_ row holding it, so
+///         clearing rows permutes indices instead of moving cells
+///         free_ scratch list of the slots released by a clear
+///         runs_ cache of the runs of each slot, for drawing
+///         run_counts_ number of runs cached for each slot, 0 if the
+///         slot changed since its runs were computed
 ///         orig_ used to store board's starting position
 ///
 private:
     matrix_type cells_;
+    rows_type rows_;
+    slots_type slots_;
+    slots_type free_;
+    mutable runs_type runs_;
+    mutable slots_type run_counts_;
     coord_type orig_;
 
 public:
@@ -45,9 +77,20 @@ public:
     ///
     board(size_type rows, size_type columns) :
         cells_(rows, columns),
+        rows_(rows, empty_row(columns)),
+        slots_(rows),
+        runs_(rows, columns),
+        run_counts_(rows, 0),
         // coordinates for placing the board in console
         orig_(make_coord(2, 1))
     {
+        assert(columns <= max_width);
+
+        for (auto i = 0u; i < rows; ++i) {
+            slots_[i] = i;
+        }
+        // reserved once, so clearing rows never allocates
+        free_.reserve(rows);
 
         // left and right walls
         for (auto i = 0u; i < rows; ++i) {
@@ -59,8 +102,29 @@ public:
         for (auto j = 0u; j < columns; ++j) {
             cells_[rows - 1][j].state_ = state::wall;
         }
+        rows_[rows - 1] = full_row();
+    }
+
+    ///
+    /// \brief copies the board; free_ is scratch and only gets its storage
+    ///         reserved, so assigning a board of the same size to the copy
+    ///         never allocates (e.g. a snapshot)
+    ///
+    board(board const& other) :
+        cells_(other.cells_),
+        rows_(other.rows_),
+        slots_(other.slots_),
+        runs_(other.runs_),
+        run_counts_(other.run_counts_),
+        orig_(other.orig_)
+    {
+        free_.reserve(other.height());
     }
 
+    board(board&&) = default;
+    board& operator=(board const&) = default;
+    board& operator=(board&&) = default;
+
     ~board() = default;
 
     ///
@@ -70,12 +134,40 @@ public:
         return orig_;
     }
 
-    line_type& operator[](size_type i) {
-        return cells_[i];
+    ///
+    /// \brief row i, the cells can be changed so its cached runs are dropped
+    ///
+    line_type operator[](size_type i) {
+        run_counts_[slots_[i]] = 0;
+        return cells_[slots_[i]];
     }
 
-    line_type const& operator[](size_type i) const {
-        return cells_[i];
+    const_line_type operator[](size_type i) const {
+        return cells_[slots_[i]];
+    }
+
+    ///
+    /// \brief row y as runs of cells in the same state, from left to right
+    ///         (computed again only if the row changed since the last call)
+    ///
+    const_runs_type runs(size_type y) const {
+        const size_type slot = slots_[y];
+        if (0 == run_counts_[slot]) {
+            const_line_type row = cells_[slot];
+            row_view<run> dst = runs_[slot];
+            size_type count = 0;
+            for (auto x = 0u; x < row.size(); ++x) {
+                if (0 == count || dst[count - 1].state_ != row[x].state_) {
+                    dst[count].state_ = row[x].state_;
+                    dst[count].length_ = 0;
+                    ++count;
+                }
+                ++dst[count - 1].length_;
+            }
+            run_counts_[slot] = count;
+        }
+
+        return const_runs_type(runs_[slot].data(), run_counts_[slot]);
     }
 
     ///
@@ -93,53 +185,102 @@ public:
     }
 
     ///
-    /// \brief used to print the board in the console and assign
-    ///         different colors for wall and the blocks that are
-    ///         applied on the board
-    ///
-    void print(console_type& con) {
-        for (auto x = 0u; x < cells_.columns(); ++x) {
-            for (auto y = 0u; y < cells_.rows(); ++y) {
-                cell const& c = cells_[y][x];
-                switch (c.state_) {
-                case state::wall:
-                    con.set_attr(8);
-                    break;
-                case state::I:
-                    con.set_attr(1);
-                    break;
-                case state::O:
-                    con.set_attr(2);
-                    break;
-                case state::T:
-                    con.set_attr(3);
-                    break;
-                case state::L:
-                    con.set_attr(4);
-                    break;
-                case state::J:
-                    con.set_attr(5);
-                    break;
-                case state::S:
-                    con.set_attr(6);
-                    break;
-                case state::Z:
-                    con.set_attr(7);
-                    break;
-                default:
-                    con.set_attr(0);
+    /// \brief returns the occupancy mask of row y
+    ///
+    row_type mask(size_type y) const noexcept {
+        return rows_[y];
+    }
+
+    ///
+    /// \brief mask of a row that has all its cells occupied
+    ///
+    static constexpr row_type full_row() noexcept {
+        return ~row_type(0);
+    }
+
+    ///
+    /// \brief mask of a row that only has the walls (and the columns
+    ///         past the right wall) set
+    ///
+    static constexpr row_type empty_row(size_type columns) noexcept {
+        return (full_row() << (columns - 1)) | row_type(1);
+    }
+
+    ///
+    /// \brief tests the piece row m placed at column x of row y against
+    ///         the board, returns true if overlap
+    ///         (cells outside of the board always overlap)
+    ///
+    bool overlap(int y, row_type m, int x) const noexcept {
+        if (y < 0 || y >= static_cast<int>(rows_.size())) {
+            return 0 != m;
+        }
+
+        if (x < 0) {
+            // cells shifted out to the left of the board
+            if (0 != (m & ~(full_row() << -x))) {
+                return true;
             }
+            return 0 != (rows_[y] & (m >> -x));
+        }
+
+        return 0 != (rows_[y] & (m << x));
+    }
 
-                /// \brief this moves the console's coursor at a certail position
-                ///         in order to print the block there
-                ///
-                con.move_cursor(make_coord(orig_.X + x * 2, orig_.Y + y));
-                con.print(' ');
-                con.print(' ');
+    ///
+    /// \brief applies the piece row m at column x of row y
+    ///         (the piece row must lie inside the board)
+    ///
+    void apply(int y, row_type m, int x, state s) {
+        rows_[y] |= (x < 0) ? (m >> -x) : (m << x);
+        run_counts_[slots_[y]] = 0;
+        for (auto i = 0; m != 0; ++i, m >>= 1) {
+            if (m & 1) {
+                cells_[slots_[y]][x + i].state_ = s;
             }
         }
     }
 
+    ///
+    /// \brief tests the rows first..last (the ones touched by the last
+    ///         applied piece) and removes the full ones: the rows above them
+    ///         are moved down in a single stable pass over the row indices and
+    ///         the released rows are emptied and reused at the top; the cells
+    ///         of the remaining rows are never moved
+    /// \return the number of removed rows
+    /// \note the moved rows keep their slot, so their cached runs as well
+    ///
+    size_type clear_full_rows(int first, int last) {
+        first = std::max(first, 0);
+        last = std::min(last, static_cast<int>(height()) - 2);
+
+        free_.clear();
+        int dst = last;
+        for (int src = last; src >= 0; --src) {
+            if (src >= first && rows_[src] == full_row()) {
+                free_.push_back(slots_[src]);
+                continue;
+            }
+
+            if (dst != src) {
+                slots_[dst] = slots_[src];
+                rows_[dst] = rows_[src];
+            }
+            --dst;
+        }
+
+        // the released rows become the new empty rows at the top
+        for (auto slot : free_) {
+            line_type row = cells_[slot];
+            std::fill(row.begin() + 1, row.end() - 1, cell());
+            run_counts_[slot] = 0;
+            slots_[dst] = slot;
+            rows_[dst] = empty_row(width());
+            --dst;
+        }
+
+        return free_.size();
+    }
 }; // struct board
 
 #endif  //BOARD_H
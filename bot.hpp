@@ -0,0 +1,193 @@
+
+/*!
+ * \file bot.hpp
+ * \brief placement policies used to play the game without a player
+ */
+
+#if !defined (_BOT_H_)
+#define _BOT_H_
+
+#include "engine.h"
+#include "../include/utils/random.hpp"
+
+#include <cstdint>
+#include <vector>
+
+///
+/// \brief plays the game by choosing a placement (rotation and column) for
+///         each block and sending the actions that move the block there
+///
+struct bot {
+    using row_type = board::row_type;
+    using rows_type = board::rows_type;
+
+    ///
+    /// \brief how the placement is chosen
+    ///         greedy the placement with the best evaluation of the board
+    ///         random any placement where the block fits
+    ///
+    enum class policy {
+        greedy,
+        random
+    };
+
+///
+/// \brief policy_ used to choose the placements
+///         rng_ used by the random policy
+///         rows_ scratch copy of the board masks, reused for every placement
+///
+private:
+    policy policy_;
+    xtd::random<int> rng_;
+    rows_type rows_;
+
+public:
+    bot() = delete;
+    bot(policy p, std::uint64_t seed) :
+        policy_(p),
+        rng_(0, 1 << 30, seed)
+    {
+    }
+
+    ///
+    /// \brief places the current block of the engine and locks it
+    ///
+    void play(engine& eng) {
+        block const& b = eng.get_block();
+        coord_type pos = b.position();
+
+        double best = 0;
+        int best_x = pos.X;
+        size_type best_rotation = 0;
+        size_type candidates = 0;
+        // only the placements the moves below reach: the block is rotated
+        // where it is, then shifted one column at a time, so a rotation is
+        // possible while every rotation before it fits, and the columns are
+        // the ones the rotated block slides to without hitting anything
+        for (auto r = 0u; r < piece_table::rotations; ++r) {
+            shape const& s = pieces(b.type(), (b.rotation() + r) % piece_table::rotations);
+            if (eng.overlap(s, pos)) {
+                break;
+            }
+
+            int left = pos.X;
+            while (!eng.overlap(s, make_coord(left - 1, pos.Y))) {
+                --left;
+            }
+            int right = pos.X;
+            while (!eng.overlap(s, make_coord(right + 1, pos.Y))) {
+                ++right;
+            }
+
+            for (auto x = left; x <= right; ++x) {
+                double value = (policy::greedy == policy_)
+                    ? evaluate(eng, s, drop(eng, s, make_coord(x, pos.Y)))
+                    : rng_.seed();
+                if (0 == candidates++ || value > best) {
+                    best = value;
+                    best_x = x;
+                    best_rotation = r;
+                }
+            }
+        }
+
+        // the moves, sent to the engine at once
+        action moves[piece_table::rotations + board::max_width + 2];
+        size_type n = 0;
+        for (auto r = 0u; r < best_rotation; ++r) {
+            moves[n++] = action::rotate;
+        }
+        for (auto x = pos.X; x < best_x; ++x) {
+            moves[n++] = action::right;
+        }
+        for (auto x = pos.X; x > best_x; --x) {
+            moves[n++] = action::left;
+        }
+        // hard drop, then lock
+        moves[n++] = action::drop;
+        moves[n++] = action::down;
+        eng.apply(moves, n);
+    }
+
+private:
+    ///
+    /// \brief lowest position the shape reaches falling from pos
+    ///
+    static coord_type drop(engine const& eng, shape const& s, coord_type pos) {
+        while (!eng.overlap(s, make_coord(pos.X, pos.Y + 1))) {
+            ++pos.Y;
+        }
+        return pos;
+    }
+
+    static int count_bits(row_type m) noexcept {
+        int n = 0;
+        for (; m != 0; m &= m - 1) {
+            ++n;
+        }
+        return n;
+    }
+
+    ///
+    /// \brief evaluates the board after placing the shape at pos, using the
+    ///         weights of the well known 4 features heuristic: aggregate height,
+    ///         complete lines, holes and bumpiness
+    ///
+    double evaluate(engine const& eng, shape const& s, coord_type pos) {
+        board const& brd = eng.get_board();
+        int height = static_cast<int>(brd.height()) - 1;    // without the bottom wall
+        int width = static_cast<int>(brd.width());
+        row_type inner = ~board::empty_row(width);
+
+        rows_.resize(height);
+        for (auto y = 0; y < height; ++y) {
+            rows_[y] = brd.mask(y) & inner;
+        }
+        for (auto y = s.top_; y <= s.bottom_; ++y) {
+            rows_[pos.Y + y] |= (pos.X < 0) ? (s.row(y) >> -pos.X) : (s.row(y) << pos.X);
+        }
+
+        int lines = 0;
+        for (auto y = 0; y < height; ++y) {
+            if (rows_[y] == inner) {
+                ++lines;
+            }
+        }
+
+        // walks the rows from the top, skipping the full ones (they are
+        // removed by the placement); remaining is the height of the current row
+        int holes = 0;
+        int heights[board::max_width] = {};
+        int remaining = height - lines;
+        row_type seen = 0;
+        for (auto y = 0; y < height; ++y) {
+            if (rows_[y] == inner) {
+                continue;
+            }
+
+            row_type fresh = rows_[y] & ~seen;
+            for (auto x = 1; fresh != 0; ++x) {
+                if (fresh & (row_type(1) << x)) {
+                    heights[x] = remaining;
+                    fresh &= ~(row_type(1) << x);
+                }
+            }
+            seen |= rows_[y];
+            holes += count_bits(seen & ~rows_[y]);
+            --remaining;
+        }
+
+        int aggregate = 0;
+        int bumpiness = 0;
+        for (auto x = 1; x < width - 1; ++x) {
+            aggregate += heights[x];
+            if (x > 1) {
+                bumpiness += (heights[x] > heights[x - 1]) ? heights[x] - heights[x - 1] : heights[x - 1] - heights[x];
+            }
+        }
+
+        return -0.510066 * aggregate + 0.760666 * lines - 0.35663 * holes - 0.184483 * bumpiness;
+    }
+}; // struct bot
+
+#endif // _BOT_H_
@@ -1,17 +1,37 @@
 
 /*!
- * \file board.hpp
- * \brief class which implements the logic of the game
+ * \file engine.h
+ * \brief class which implements the logic of the game (no console dependency,
+ *        see renderer.hpp for drawing it)
  */
 
 #if !defined (_ENGINE_H__)
 #define _ENGINE_H__
 
 #include "blocks.hpp"
-#include "../include/utils/random.hpp"
+#include "randomizer.hpp"
+#include "utils/bits.hpp"
 
 #include <string>
-#include <stdio.h>
+#include <cstdint>
+
+///
+/// \brief what the player (a key, see keymap.hpp), a bot or the gravity asks
+///			the game to do; pause, stats and theme are not moves of the game,
+///			they are handled by the caller
+///
+enum class action : unsigned char {
+	none,
+	rotate,
+	left,
+	right,
+	down,
+	drop,
+	quit,
+	pause,
+	stats,
+	theme
+};
 
 ///
 /// \brief class which implements the logic of the game
@@ -21,51 +41,83 @@ struct engine {
 
 ///
 /// \brief finish_ true leads to game over
-///			pattern_ is a string applied to block to set its shape and color
-///			rng_ uses a random number generator from class random
+///			pieces_queue_ generates the pieces and holds the preview of the next ones
+///			pieces_, lines_ number of locked pieces and of cleared lines
+///			revision_ changed every time the game changes (what is drawn of it)
+///			fall_ticks_ ticks since the block last fell by itself
+///			lock_delay_ ticks a block waits on the stack before it is locked
+///			lock_ticks_ ticks the block has been on the stack
 /// 
 private:
 	bool finish_;
-	std::vector<string_type> pattern_;
 	board board_;
 	block block_;
 	int score_;
-	xtd::random<int> rng_;
+	randomizer pieces_queue_;
 	int speed_;
+	size_type pieces_;
+	size_type lines_;
+	std::uint64_t revision_;
+	int fall_ticks_;
+	int lock_delay_;
+	int lock_ticks_;
 
 public:
+	// the simulation clock, see tick(); speed() is in milliseconds
+	enum : int { tick_rate = 1000 };
+
 	engine() = delete;
 	~engine() = default;
 
-	engine(short_type rows_board, short_type columns_board, short_type rows_block, short_type columns_block) :
+	engine(short_type rows_board, short_type columns_board, randomizer::kind k = randomizer::kind::bag) :
 		finish_(false),
-		// the patterns, stored as strings, which will be applyed to block to give its shape
-		pattern_(
-			{
-				"....IIII........",
-				".....OO..OO.....",
-				"......T..TTT....",
-				".....L...L...LL.",
-				"......J...J..JJ.",
-				".....S...SS...S.",
-				"......Z..ZZ..Z.."
-			}
+		board_(rows_board, columns_board),
+		block_(
+			piece::I,
+			make_coord(
+				board_.width() / 2 - piece_table::size / 2,
+				0
+				)
 			),
+		score_(0),
+		// the generator choosing the pieces
+		pieces_queue_(k),
+		speed_(500),
+		pieces_(0),
+		lines_(0),
+		revision_(0),
+		fall_ticks_(0),
+		lock_delay_(0),
+		lock_ticks_(0)
+	{	// constructor initiates a block with random piece
+		block_.init(pieces_queue_.next());
+	}
+
+	///
+	/// \brief	same as above, but the pieces come from an explicitly seeded generator
+	///			so the game can be reproduced (same seed and inputs, same game)
+	///
+	engine(short_type rows_board, short_type columns_board, std::uint64_t seed, randomizer::kind k = randomizer::kind::bag) :
+		finish_(false),
 		board_(rows_board, columns_board),
 		block_(
-			rows_block,
-			columns_block,
+			piece::I,
 			make_coord(
-				board_.width() / 2 - columns_block / 2,
+				board_.width() / 2 - piece_table::size / 2,
 				0
 				)
 			),
 		score_(0),
-		// generate a random number to choose one of the patterns
-		rng_(0, 6),
-		speed_(500)
-	{	// constructor initiates a block with random pattern
-		block_.init(pattern_[rng_.seed()]);
+		pieces_queue_(k, seed),
+		speed_(500),
+		pieces_(0),
+		lines_(0),
+		revision_(0),
+		fall_ticks_(0),
+		lock_delay_(0),
+		lock_ticks_(0)
+	{
+		block_.init(pieces_queue_.next());
 	}
 
 	size_type board_width() const noexcept {
@@ -85,89 +137,253 @@ public:
 	}
 
 	///
-	/// \brief	prints the board, block and score in the console
-	/// 
-	void draw(console_type& con) {
-		board_.print(con);
-		block_.print(con, board_.origin());
-		draw_score(con);
-		con.refresh();
+	/// \brief	the number of ticks between two falls of the block
+	///
+	int gravity_ticks() const noexcept {
+		return speed_ * tick_rate / 1000;
 	}
 
 	///
-	/// \brief	moves the block based on keyboard inputs by creating a temporary
-	///			block and checking for overlap between tmp block's cells and board cells
-	///
-	void handle_event(events::event_type ev) {
-		if (events::kind::key == ev.type) {
-			block tmp(block_);
-			bool changed = true;
-			bool down = false;
-
-			switch (ev.key) {
-			case 'Q':
-			case 'q':
-				changed = false;
-				finish_ = true;
-				break;
-			case 'W':
-			case 'w':
-				tmp.rotate_right();
-				break;
-			case 'A':
-			case 'a':
-				tmp.move_left();
-				break;
-			case 'D':
-			case 'd':
-				tmp.move_right();
-				break;
-			case 'S':
-			case 's':
-				down = true;
-				tmp.move_down();
-				break;
-			// moves block to the lowest available position underneath it
-			case ' ':
-				down = true;
-				while (!overlap(tmp)) {
-					tmp.move_down();
-				}
-				// moves block up before applying because the tmp block will always overlap not empty cells in its final position
-				tmp.move_up();
-				break;
-			default:
-				changed = false;
-				break;
+	/// \brief	the number of ticks a block resting on the stack waits before it
+	///			is locked, 0 locks it at the first fall it cannot make (default)
+	///
+	int lock_delay() const noexcept {
+		return lock_delay_;
+	}
+
+	void set_lock_delay(int ticks) noexcept {
+		lock_delay_ = ticks;
+		lock_ticks_ = 0;
+	}
+
+	///
+	/// \brief	the i-th upcoming piece (0 is the next one), i < randomizer::preview_size
+	///
+	piece preview(size_type i) const {
+		return pieces_queue_.peek(i);
+	}
+
+	size_type piece_count() const noexcept {
+		return pieces_;
+	}
+
+	size_type line_count() const noexcept {
+		return lines_;
+	}
+
+	///
+	/// \brief	a number that changes every time the board, the block, the score
+	///			or the preview change, e.g. to draw a game only if it changed
+	///
+	std::uint64_t revision() const noexcept {
+		return revision_;
+	}
+
+	///
+	/// \brief	read only access for the renderers
+	///
+	board const& get_board() const noexcept {
+		return board_;
+	}
+
+	block const& get_block() const noexcept {
+		return block_;
+	}
+
+	///
+	/// \brief	moves the block by computing the candidate position and rotation
+	///			and checking them for overlap against the board, without building
+	///			a temporary block (no allocation, no copy)
+	///
+	void apply(action a) {
+		coord_type pos = block_.position();
+		size_type rotation = block_.rotation();
+		bool changed = true;
+		bool down = false;
+
+		switch (a) {
+		case action::quit:
+			changed = false;
+			finish_ = true;
+			break;
+		case action::rotate:
+			rotation = (rotation + 1) % piece_table::rotations;
+			break;
+		case action::left:
+			--pos.X;
+			break;
+		case action::right:
+			++pos.X;
+			break;
+		case action::down:
+			down = true;
+			++pos.Y;
+			break;
+		// moves block to the lowest available position underneath it
+		case action::drop:
+			down = true;
+			while (!overlap(block_.get_shape(), pos)) {
+				++pos.Y;
 			}
+			// moves block up before applying because the block will always overlap not empty cells in its final position
+			--pos.Y;
+			break;
+		default:
+			changed = false;
+			break;
+		}
 
-			if (changed) {
-				if (!overlap(tmp)) {
-					block_ = std::move(tmp);
-				}
-				// after the block is applied to the board, board is tested for full rows and a new block is created
-				else if (down) {
-					apply_block();
-					test_for_full_rows();
-					create_block();
-				}
+		if (changed) {
+			if (!overlap(pieces(block_.type(), rotation), pos)) {
+				block_.set_position(pos);
+				block_.set_rotation(rotation);
+				++revision_;
+			}
+			// after the block is applied to the board, board is tested for full rows and a new block is created
+			else if (down) {
+				apply_block();
+				++pieces_;
+				test_for_full_rows();
+				create_block();
+				++revision_;
+			}
+		}
+	}
+
+	///
+	/// \brief	applies n actions in a row, e.g. a bot's moves or a replay
+	///
+	void apply(action const* actions, size_type n) {
+		for (auto i = 0u; i < n; ++i) {
+			apply(actions[i]);
+		}
+	}
+
+	///
+	/// \brief	the number of columns the block can move to the left (dx < 0) or to
+	///			the right (dx > 0) before it hits the stack or a wall, found with
+	///			one mask operation per row of the block (the cells of a piece row
+	///			are contiguous, so only its first cell in the direction matters)
+	///
+	int reach(int dx) const noexcept {
+		shape const& s = block_.get_shape();
+		coord_type pos = block_.position();
+		// shifted by margin columns so the cells left of the board fit; the
+		// columns outside of the board are occupied
+		constexpr int margin = piece_table::size;
+		constexpr std::uint64_t outside = (std::uint64_t(1) << margin) - 1;
+		constexpr int row_bits = sizeof(board::row_type) * 8;
+		int d = static_cast<int>(board_.width());
+
+		for (auto y = s.top_; y <= s.bottom_; ++y) {
+			int by = pos.Y + y;
+			if (by < 0 || by >= static_cast<int>(board_.height())) {
+				return 0;
+			}
+
+			std::uint64_t cells = std::uint64_t(s.row(y)) << (pos.X + margin);
+			if (0 == cells) {
+				continue;
+			}
+			std::uint64_t occupied = (std::uint64_t(board_.mask(by)) << margin) | outside | (~std::uint64_t(0) << (row_bits + margin));
+			if (0 != (cells & occupied)) {
+				// a new block on top of the stack does not move
+				return 0;
 			}
+
+			int free = 0;
+			if (dx < 0) {
+				int first = xtd::lowest_bit(cells);
+				free = first - xtd::highest_bit(occupied & ((std::uint64_t(1) << first) - 1)) - 1;
+			}
+			else {
+				int last = xtd::highest_bit(cells);
+				free = xtd::lowest_bit(occupied & ~((std::uint64_t(2) << last) - 1)) - last - 1;
+			}
+			d = (free < d) ? free : d;
 		}
+
+		return d;
 	}
 
 	///
-	/// \brief	checks block's cells one by one and board cells underneath block for overlap
-	///			returns true if overlap
+	/// \brief	moves the block by up to n columns (n < 0 to the left) as far as it
+	///			goes, e.g. to the wall at once; returns the number of columns moved
+	///
+	int shift(int n) {
+		int d = reach(n);
+		int count = (n < 0) ? -n : n;
+		count = (d < count) ? d : count;
+		if (count > 0) {
+			coord_type pos = block_.position();
+			pos.X += static_cast<short_type>((n < 0) ? -count : count);
+			block_.set_position(pos);
+			++revision_;
+		}
+		return count;
+	}
+
+	///
+	/// \brief	advances the game by one tick of the simulation clock (1 / tick_rate
+	///			seconds): the block falls every gravity_ticks(), and with a lock
+	///			delay it is locked after resting lock_delay() ticks on the stack
+	///
+	void tick() {
+		if (lock_delay_ > 0) {
+			if (!grounded()) {
+				lock_ticks_ = 0;
+			}
+			else if (++lock_ticks_ >= lock_delay_) {
+				lock_ticks_ = 0;
+				// the block cannot move down, so it is locked
+				apply(action::down);
+			}
+		}
+
+		if (++fall_ticks_ >= gravity_ticks()) {
+			fall_ticks_ = 0;
+			if (0 == lock_delay_ || !grounded()) {
+				apply(action::down);
+			}
+		}
+	}
+
+	///
+	/// \brief	the number of ticks until tick() changes the game by itself, so a
+	///			caller can sleep until then (keys aside)
+	///
+	int idle_ticks() const {
+		int ticks = gravity_ticks() - fall_ticks_;
+		if (lock_delay_ > 0 && grounded() && lock_delay_ - lock_ticks_ < ticks) {
+			ticks = lock_delay_ - lock_ticks_;
+		}
+		return (ticks > 0) ? ticks : 1;
+	}
+
+	///
+	/// \brief	true if the block rests on the stack (or on the floor)
+	///
+	bool grounded() const {
+		coord_type pos = block_.position();
+		++pos.Y;
+		return overlap(block_.get_shape(), pos);
+	}
+
+	///
+	/// \brief	checks block's rows against the board rows underneath block, using
+	///			the occupancy masks of both; returns true if overlap
 	///
 	bool overlap(block const& b) const {
-		for (auto x = 0u; x < b.width(); ++x) {
-			for (auto y = 0u; y < b.height(); ++y) {
-				if (b[y][x].state_ != state::empty) {
-					coord_type pos = b.position();
-					if (board_[pos.Y + y][pos.X + x].state_ != state::empty) {
-						return true;
-					}
-				}
+		return overlap(b.get_shape(), b.position());
+	}
+
+	///
+	/// \brief	checks the shape placed at pos against the board; returns true if overlap
+	///
+	bool overlap(shape const& s, coord_type pos) const {
+		for (auto y = s.top_; y <= s.bottom_; ++y) {
+			if (board_.overlap(pos.Y + y, s.row(y), pos.X)) {
+				return true;
 			}
 		}
 
@@ -175,61 +391,37 @@ public:
 	}
 
 	///
-	/// \brief	changes the board's cells state based on the block's cells state
+	/// \brief	changes the board's cells state and occupancy based on the block's cells
 	///
 	void apply_block() {
+		shape const& s = block_.get_shape();
 		coord_type pos = block_.position();
-		for (auto x = 0u; x < block_.width(); ++x) {
-			for (auto y = 0u; y < block_.height(); ++y) {
-				if (block_[y][x].state_ != state::empty) {
-					board_[pos.Y + y][pos.X + x].state_ = block_[y][x].state_;
-				}
-			}
+		for (auto y = s.top_; y <= s.bottom_; ++y) {
+			board_.apply(pos.Y + y, s.row(y), pos.X, block_.kind());
 		}
 	}
 
 	///
-	/// \brief	tests if rows are full, deletes full rows and updates score and speed
+	/// \brief	tests the rows touched by the block just applied for full rows, deletes
+	///			the full ones and updates score and speed
 	///
 	void test_for_full_rows() {
-		bool full_row = false;
-		int rows = 0;
+		shape const& s = block_.get_shape();
+		coord_type pos = block_.position();
+		auto rows = board_.clear_full_rows(pos.Y + s.top_, pos.Y + s.bottom_);
+		lines_ += rows;
 
-		for (int y = board_.height() - 2; y > 0; --y) {
-			for (int x = board_.width() - 1; x > 0; --x) {
-				if (board_[y][x].state_ != state::empty) {
-					full_row = true;
-				}
-				else {
-					full_row = false;
-				}
-				if (!full_row)
-					break;
+		if (rows >= 4) {
+			score_ += 100;
+			if (speed_ > 150) {
+				speed_ -= 10;
 			}
-
-			if (full_row) {
-				++rows; 
-				for (int i = y; i > 0; --i) {
-					for (int j = board_.width() - 1; j > 0; --j) {
-						board_[i][j] = board_[i - 1][j];
-					}
-				}
-
-				++y; // goes to the next rows
-
-				if (rows > 0 && rows < 4) {
-					score_ += 10;
-					if (speed_ > 150) {
-						speed_ -= 5;
-					}
-					rows = 0;
-				}
-				else if (rows >= 4) {
-					score_ += 100;
-					if (speed_ > 150) {
-						speed_ -= 10;
-					}
-					rows = 0;
+		}
+		else {
+			for (auto i = 0u; i < rows; ++i) {
+				score_ += 10;
+				if (speed_ > 150) {
+					speed_ -= 5;
 				}
 			}
 		}
@@ -239,9 +431,11 @@ public:
 	/// \brief	ends the game by setting finish_ to true if board's upper cells are full
 	///
 	bool game_over() {
+		// read only, the rows keep their cached runs
+		board const& b = board_;
 		for (auto x = 0u; x < 2; ++x) {
 			for (auto y = (board_.width() / 2) - (block_.width() / 2); y < (board_.width() / 2) + (block_.width() / 2); ++y) {
-				if (board_[x][y].state_ != state::empty) {
+				if (b[x][y].state_ != state::empty) {
 					finish_ = true;
 				}
 			}
@@ -249,25 +443,12 @@ public:
 		return finish_;
 	}
 	
-	///
-	/// \brief	prints score in the console
-	///
-	void draw_score(console_type& con) {
-		con.set_attr(2);
-		con.move_cursor(make_coord(2, board_.height() + 1));
-		con.print(L"Score: ");
-		// transforms integers to text for print
-		wchar_t tmp[32];
-		_snwprintf_s(tmp, sizeof(tmp) / sizeof(tmp[0]), L"%d", score_);
-		con.print(tmp);
-	}
-
 private:
 	///
 	/// \brief	creates a new block after block apply to board
 	///
 	void create_block() {
-		block_.init(pattern_[rng_.seed()]);
+		block_.init(pieces_queue_.next());
 		block_.set_position(make_coord(board_.width() / 2 - block_.width() / 2, 0));
 	}
 }; // struct engine
@@ -1 +1,231 @@
 #pragma once
+
+/*
+ * \file  Queue.h
+ * \brief template queue implementation (fixed capacity ring buffer, statically allocated)
+ */
+
+#if !defined(QUEUE_H__)
+#define QUEUE_H__
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+namespace xtd {
+
+    ///
+    /// \brief queue structure
+    ///
+    template <
+        typename T,
+        std::size_t N
+        >
+    struct queue {
+        using value_type = T;
+        using reference = value_type&;
+        using const_reference = value_type const&;
+        using size_type = std::size_t;
+
+    private:
+        std::size_t head_;
+        std::size_t count_;
+        value_type arr_[N];
+
+    public:
+        queue() :
+            head_(0),
+            count_(0)
+        {
+        }
+
+        ///
+        /// \brief empty
+        /// \return
+        ///
+        bool empty() const noexcept {
+            return (0 == count_);
+        }
+
+        ///
+        /// \brief full
+        /// \return
+        ///
+        bool full() const noexcept {
+            return (N == count_);
+        }
+
+        ///
+        /// \brief Returns the number of elements in the underlying container
+        /// \return The number of elements in the container
+        ///
+        size_type size() const noexcept {
+            return count_;
+        }
+
+        ///
+        /// \brief Returns the maximum number of elements
+        ///
+        static constexpr size_type capacity() noexcept {
+            return N;
+        }
+
+        ///
+        /// \brief Pushes the given element value to the back of the queue
+        /// \param elem
+        ///
+        void push(value_type elem) {
+            if (full()) {
+                throw std::overflow_error("Queue full!");
+            }
+
+            arr_[(head_ + count_) % N] = elem;
+            ++count_;
+        }
+
+        ///
+        /// \brief Returns reference to the first element in the queue.
+        /// 	   This element will be the first element to be removed
+        /// 	   on a call to pop().
+        /// \return Reference to the first element.
+        ///
+        const_reference front() const {
+            if (empty()) {
+                throw std::underflow_error("Queue empty!");
+            }
+
+            return arr_[head_];
+        }
+
+        ///
+        /// \brief Returns reference to the i-th element from the front
+        ///        (0 is the front), without removing it
+        ///
+        const_reference operator[](size_type i) const {
+            if (i >= count_) {
+                throw std::out_of_range("Queue index out of range!");
+            }
+
+            return arr_[(head_ + i) % N];
+        }
+
+        ///
+        /// \brief Removes an element from the front of the queue
+        /// \return
+        ///
+        value_type pop() {
+            if (empty()) {
+                throw std::underflow_error("Queue empty!");
+            }
+
+            value_type elem = arr_[head_];
+            head_ = (head_ + 1) % N;
+            --count_;
+            return elem;
+        }
+    };
+
+    ///
+    /// \brief bounded queue passing values from one producer thread to one
+    ///        consumer thread without locks; push() and pop() never wait
+    ///        and never throw, they fail if the queue is full (empty)
+    ///
+    template <
+        typename T,
+        std::size_t N
+        >
+    struct spsc_queue {
+        using value_type = T;
+        using const_pointer = value_type const*;
+        using size_type = std::size_t;
+
+        static_assert(N > 0 && 0 == (N & (N - 1)), "spsc_queue: the capacity must be a power of 2");
+
+    private:
+        static constexpr size_type mask = N - 1;
+
+        value_type arr_[N];
+        // free running counters: head_ written by the consumer only,
+        // tail_ by the producer only, each on its own cache line
+        alignas(64) std::atomic<size_type> head_;
+        alignas(64) std::atomic<size_type> tail_;
+
+    public:
+        spsc_queue() :
+            head_(0),
+            tail_(0)
+        {
+        }
+
+        spsc_queue(spsc_queue const&) = delete;
+        spsc_queue& operator=(spsc_queue const&) = delete;
+
+        ///
+        /// \brief Returns the maximum number of elements
+        ///
+        static constexpr size_type capacity() noexcept {
+            return N;
+        }
+
+        ///
+        /// \brief true if there is nothing to pop (exact for the consumer)
+        ///
+        bool empty() const noexcept {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+        ///
+        /// \brief true if there is no room to push (exact for the producer)
+        ///
+        bool full() const noexcept {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire) == N;
+        }
+
+        ///
+        /// \brief Pushes the given element value to the back of the queue
+        ///        (producer only)
+        /// \return false if the queue is full
+        ///
+        bool push(value_type const& elem) {
+            size_type tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) == N) {
+                return false;
+            }
+
+            arr_[tail & mask] = elem;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        ///
+        /// \brief the first element, without removing it (consumer only)
+        /// \return nullptr if the queue is empty
+        ///
+        const_pointer peek() const noexcept {
+            size_type head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+
+            return &arr_[head & mask];
+        }
+
+        ///
+        /// \brief Removes the first element into elem (consumer only)
+        /// \return false if the queue is empty
+        ///
+        bool pop(value_type& elem) {
+            size_type head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            elem = arr_[head & mask];
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+} // namespace xtd
+
+#endif // QUEUE_H__
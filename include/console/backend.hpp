@@ -0,0 +1,173 @@
+
+/*!
+ * \brief C++ console framework, requirements of a console backend
+ * \file  backend.hpp
+ */
+
+#if !defined(BACKEND_H__)
+#define BACKEND_H__
+
+#include "console/types.hpp"
+#include "console/stats.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace xtd {
+
+    namespace detail {
+
+        template <typename...>
+        struct make_void {
+            using type = void;
+        };
+
+        template <typename... Ts>
+        using void_t = typename make_void<Ts...>::type;
+
+        template <typename T, typename = void>
+        struct is_console_backend :
+            public std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_console_backend<T, void_t<
+            typename T::char_type,
+            typename T::color_type,
+            decltype(std::declval<T&>().add_attr(0, std::declval<typename T::color_type>(), std::declval<typename T::color_type>())),
+            decltype(std::declval<T&>().set_attr(0)),
+            decltype(std::declval<T&>().move_cursor(std::declval<coord_type>())),
+            decltype(std::declval<T&>().print(std::declval<typename T::char_type>())),
+            decltype(std::declval<T&>().print(std::declval<typename T::char_type const*>())),
+            decltype(std::declval<T&>().refresh()),
+            decltype(std::declval<T&>().clear_area(std::declval<coord_type>(), std::declval<coord_type>()))
+            >> :
+            public std::true_type
+        {
+        };
+
+        template <typename T, typename = void>
+        struct has_frame_stats :
+            public std::false_type
+        {
+        };
+
+        template <typename T>
+        struct has_frame_stats<T, void_t<
+            decltype(std::declval<T const&>().stats())
+            >> :
+            public std::is_convertible<decltype(std::declval<T const&>().stats()), frame_stats>
+        {
+        };
+
+        template <typename T, typename = void>
+        struct has_frames :
+            public std::false_type
+        {
+        };
+
+        template <typename T>
+        struct has_frames<T, void_t<
+            decltype(std::declval<T&>().begin_frame()),
+            decltype(std::declval<T&>().end_frame())
+            >> :
+            public std::true_type
+        {
+        };
+
+        template <typename T>
+        void frame_begin(T& con, std::true_type) {
+            con.begin_frame();
+        }
+
+        template <typename T>
+        void frame_begin(T&, std::false_type) noexcept {
+        }
+
+        template <typename T>
+        void frame_end(T& con, std::true_type) {
+            con.end_frame();
+        }
+
+        template <typename T>
+        void frame_end(T&, std::false_type) noexcept {
+        }
+
+    } // namespace detail
+
+    /*!
+     * \brief true if T can be drawn on, i.e. it has the drawing functions of
+     *        the consoles (add_attr, set_attr, move_cursor, print, refresh
+     *        and clear_area)
+     *
+     * \note
+     * The drawing code takes the backend as a template parameter (checked
+     * with this trait), the calls are resolved at compile time.
+     */
+    template <typename T>
+    struct is_console_backend :
+        public detail::is_console_backend<T>
+    {
+    };
+
+    /*!
+     * \brief true if the console backend T counts its output, i.e. has
+     *        stats() returning the frame_stats of the last frame
+     */
+    template <typename T>
+    struct has_frame_stats :
+        public detail::has_frame_stats<T>
+    {
+    };
+
+    /*!
+     * \brief true if the console backend T can send the refresh()es of a
+     *        frame together, i.e. has begin_frame() and end_frame()
+     */
+    template <typename T>
+    struct has_frames :
+        public detail::has_frames<T>
+    {
+    };
+
+    /*!
+     * \brief begin_frame() / end_frame() of the console, if it has them
+     */
+    template <typename T>
+    void frame_begin(T& con) {
+        detail::frame_begin(con, has_frames<T>());
+    }
+
+    template <typename T>
+    void frame_end(T& con) {
+        detail::frame_end(con, has_frames<T>());
+    }
+
+    /*!
+     * \brief frame_scope
+     * the refresh()es of the console between the construction and the
+     * destruction are sent as one frame (if the console can)
+     */
+    template <typename T>
+    struct frame_scope {
+    private:
+        T& con_;
+
+    public:
+        frame_scope(frame_scope const&) = delete;
+        frame_scope& operator=(frame_scope const&) = delete;
+
+        explicit frame_scope(T& con) :
+            con_(con)
+        {
+            frame_begin(con_);
+        }
+
+        ~frame_scope() {
+            frame_end(con_);
+        }
+    };
+
+} // namespace xtd
+
+#endif // BACKEND_H__
@@ -0,0 +1,18 @@
+
+/*!
+ * \brief C++ console framework, the color codes of the platform
+ * \file  color.hpp
+ */
+
+#if !defined(COLOR_H__)
+#define COLOR_H__
+
+#include "utils/system.hpp"
+
+#if defined(OS_LINUX)
+#include "linux/events.hpp"
+#elif defined(OS_WIN)
+#include "windows/attribute.hpp"
+#endif //
+
+#endif // COLOR_H__
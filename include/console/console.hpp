@@ -10,7 +10,12 @@
 #include "utils/system.hpp"
 
 #if defined(OS_LINUX)
+// XTD_CONSOLE_ANSI selects the raw ANSI terminal backend instead of curses
+#if defined(XTD_CONSOLE_ANSI)
+#include "linux/ansi.hpp"
+#else
 #include "linux/console.hpp"
+#endif
 #elif defined(OS_WIN)
 #include "windows/console.hpp"
 #endif //
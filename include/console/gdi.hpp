@@ -8,6 +8,7 @@
 #define GDI_H__
 
 #include "console.hpp"
+#include "backend.hpp"
 #include <algorithm>
 
 namespace xtd {
@@ -17,6 +18,7 @@ namespace xtd {
         >
     struct gdi {
         using console_type = T;
+        static_assert(is_console_backend<console_type>::value, "gdi needs a console backend");
 //        using char_type = typename console_type::char_type;
 
     private:
@@ -0,0 +1,953 @@
+
+/*!
+ * \brief C++ console framework (Linux), raw ANSI terminal backend
+ * \file  ansi.hpp
+ *
+ * The same interface as the curses console, without curses: the drawing
+ * goes to a buffer of cells in user space and refresh() sends the cells
+ * that changed since the previous refresh with a single write(), using the
+ * shortest cursor moves and only the color changes that are needed.
+ * The input is read from the terminal in raw mode (termios).
+ *
+ * The refresh()es between begin_frame() and end_frame() are sent once, at
+ * end_frame(); if the terminal supports the synchronized update mode (DEC
+ * private mode 2026) every frame is sent as one synchronized update, so
+ * the terminal never shows half of a frame.
+ *
+ * Selected instead of the curses console with XTD_CONSOLE_ANSI.
+ */
+
+#if !defined(LINUX_ANSI_H__)
+#define LINUX_ANSI_H__
+
+#include "console/types.hpp"
+#include "events.hpp"
+#include "console/stats.hpp"
+#include <termios.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+namespace xtd {
+
+    /*!
+     * \brief events read from a terminal in raw mode (keys only)
+     *
+     * The arrow keys are escape sequences, whose bytes may come in several
+     * reads (e.g. over ssh): after an ESC the next bytes are waited for
+     * escape_delay milliseconds. A sequence is read up to its final byte
+     * and only the arrows are keys, the other sequences are dropped; an ESC
+     * without a sequence is the escape key (and an Alt+key is ESC, then the
+     * key).
+     */
+    struct ansi_events :
+        public event_types
+    {
+        // the arrow keys (the same codes as curses' KEY_*)
+        enum : int {
+            key_down = 0402,
+            key_up = 0403,
+            key_left = 0404,
+            key_right = 0405
+        };
+
+        enum : int {
+            // milliseconds waited for the rest of an escape sequence
+            escape_delay = 50,
+            // bytes read ahead and kept for read()
+            pending_size = 64
+        };
+
+    private:
+        int timeout_;
+        // written by interrupt(), read end polled by wait()
+        int wake_[2];
+        // the bytes read and not handed out yet, first_ .. last_ - 1
+        unsigned char pending_[pending_size];
+        int first_;
+        int last_;
+
+    public:
+        ansi_events() :
+            timeout_(0),
+            first_(0),
+            last_(0)
+        {
+            if (0 != ::pipe(wake_)) {
+                wake_[0] = wake_[1] = -1;
+            }
+        }
+
+        ansi_events(ansi_events const&) = delete;
+        ansi_events& operator=(ansi_events const&) = delete;
+
+        ~ansi_events() {
+            if (wake_[0] >= 0) {
+                ::close(wake_[0]);
+                ::close(wake_[1]);
+            }
+        }
+
+        /*!
+         * \brief timeout of read() in milliseconds
+         *      > 0 timeout
+         *      = 0 non-blocking
+         *      < 0 blocking
+         */
+        void set_timeout(int tm) noexcept {
+            timeout_ = tm;
+        }
+
+        /*!
+         * \brief Read the next available console event
+         * \return an event of kind none if there was no input
+         *         before the timeout, or only a sequence which is
+         *         not a key
+         */
+        event_type read() {
+            event_type ev;
+            unsigned char c;
+
+            if (!next(c, timeout_)) {
+                // no event available
+                return ev;
+            }
+
+            if (27 == c) {
+                return escape();
+            }
+
+            ev.type = kind::key;
+            ev.key = c;
+            return ev;
+        }
+
+        /*!
+         * \brief waits for input, without reading it
+         * \param tm milliseconds
+         *      > 0 timeout
+         *      = 0 does not wait
+         *      < 0 until there is input
+         * \return true if there is input, false after interrupt()
+         */
+        bool wait(int tm) const noexcept {
+            return first_ != last_ || poll(tm);
+        }
+
+        /*!
+         * \brief makes the current and the next wait() return false at once
+         *        (e.g. to stop a thread reading the input; thread safe)
+         */
+        void interrupt() noexcept {
+            char c = 0;
+            if (wake_[1] >= 0 && 1 != ::write(wake_[1], &c, 1)) {
+                // nothing to do, the pipe is not full with one byte
+            }
+        }
+
+        /*!
+         * \brief reads the terminal's replies to a DECRQM query of the mode
+         *        followed by a DA1 query (ESC [ c), which every terminal
+         *        answers: waits at most tm milliseconds for the DA1 reply;
+         *        the input that is not a reply (e.g. keys typed meanwhile)
+         *        is kept for read()
+         * \return the value of the mode (0 if not answered)
+         */
+        int mode_reply(int mode, int tm) {
+            using clock_type = std::chrono::steady_clock;
+            auto deadline = clock_type::now() + std::chrono::milliseconds(tm);
+            auto left = [&deadline]() {
+                auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock_type::now()).count();
+                return (ms > 0) ? static_cast<int>(ms) : 0;
+            };
+
+            int value = 0;
+            unsigned char seq[32];
+            int n = 0;
+            while (poll(left()) && 1 == ::read(STDIN_FILENO, &seq[n], 1)) {
+                ++n;
+                if (27 != seq[0]) {
+                    keep(seq, n);
+                    n = 0;
+                    continue;
+                }
+                // a reply is ESC [ ? then parameters, up to its final byte
+                unsigned char c = seq[n - 1];
+                bool prefix = (1 == n) || (2 == n && '[' == c) || (3 == n && '?' == c);
+                bool inside = n > 3 && c >= 0x20 && c <= 0x3F && n < static_cast<int>(sizeof(seq));
+                if (prefix || inside) {
+                    continue;
+                }
+
+                if (n > 3 && 'c' == c) {
+                    // DA1, the last reply
+                    return value;
+                }
+                int code = 0;
+                int i = 3;
+                for (; i < n && seq[i] >= '0' && seq[i] <= '9'; ++i) {
+                    code = code * 10 + (seq[i] - '0');
+                }
+                if ('y' == c && n > i + 3 && ';' == seq[i] && '$' == seq[n - 2]) {
+                    // DECRQM: ESC [ ? mode ; value $ y
+                    if (code == mode) {
+                        value = seq[i + 1] - '0';
+                    }
+                }
+                else {
+                    keep(seq, n);
+                }
+                n = 0;
+            }
+
+            keep(seq, n);
+            return value;
+        }
+
+    private:
+        bool poll(int tm) const noexcept {
+            pollfd fds[2] = { { STDIN_FILENO, POLLIN, 0 }, { wake_[0], POLLIN, 0 } };
+            return ::poll(fds, 2, tm) > 0 && 0 == (fds[1].revents & POLLIN) && 0 != (fds[0].revents & POLLIN);
+        }
+
+        /*!
+         * \brief keeps the bytes for read(), after the ones kept
+         */
+        void keep(unsigned char const* bytes, int n) noexcept {
+            for (auto i = 0; i < n && last_ < pending_size; ++i) {
+                pending_[last_++] = bytes[i];
+            }
+        }
+
+        /*!
+         * \brief the next byte, kept or read within tm milliseconds
+         */
+        bool next(unsigned char& c, int tm) noexcept {
+            if (first_ != last_) {
+                c = pending_[first_++];
+                return true;
+            }
+
+            return wait(tm) && 1 == ::read(STDIN_FILENO, &c, 1);
+        }
+
+        /*!
+         * \brief gives the byte back, it is the next one read
+         */
+        void unget(unsigned char c) noexcept {
+            if (first_ == last_) {
+                first_ = last_ = 0;
+            }
+            if (first_ > 0) {
+                pending_[--first_] = c;
+            }
+            else if (last_ < pending_size) {
+                std::memmove(pending_ + 1, pending_, static_cast<std::size_t>(last_));
+                pending_[0] = c;
+                ++last_;
+            }
+        }
+
+        /*!
+         * \brief reads what follows an ESC: the arrows are sent as
+         *        ESC [ A..D or ESC O A..D, a sequence is ESC [ (or ESC O)
+         *        then parameter (0x30-0x3F) and intermediate (0x20-0x2F)
+         *        bytes, up to a final byte (0x40-0x7E)
+         */
+        event_type escape() {
+            event_type ev;
+            ev.type = kind::key;
+            ev.key = 27;
+
+            unsigned char c;
+            if (!next(c, escape_delay)) {
+                // the escape key
+                return ev;
+            }
+            if ('[' != c && 'O' != c) {
+                // not a sequence, e.g. Alt+key: the key is read next
+                unget(c);
+                return ev;
+            }
+
+            ev.type = kind::none;
+            bool csi = ('[' == c);
+            bool parameters = false;
+            while (next(c, escape_delay)) {
+                if (c >= 0x40 && c <= 0x7E) {
+                    if (!parameters) {
+                        switch (c) {
+                        case 'A':
+                            ev.type = kind::key;
+                            ev.key = key_up;
+                            break;
+                        case 'B':
+                            ev.type = kind::key;
+                            ev.key = key_down;
+                            break;
+                        case 'C':
+                            ev.type = kind::key;
+                            ev.key = key_right;
+                            break;
+                        case 'D':
+                            ev.type = kind::key;
+                            ev.key = key_left;
+                            break;
+                        }
+                    }
+                    return ev;
+                }
+                if (!csi || c < 0x20 || c > 0x3F) {
+                    // not a valid sequence, the byte is not part of it
+                    // (e.g. the ESC of the next one)
+                    unget(c);
+                    return ev;
+                }
+                parameters = true;
+            }
+
+            // cut short, dropped
+            return ev;
+        }
+    };
+
+
+    /*
+     * \brief console drawing with ANSI escape sequences
+     */
+    struct ansi_console {
+        using char_type = traits::char_type;
+        using events_type = ansi_events;
+        using color_type = color;
+        using pair_type = std::pair<color_type, color_type>;
+
+        // the attributes are the keys 0 .. max_attr - 1
+        static constexpr int max_attr = 256;
+
+        /*!
+         * \brief The visibility enum
+         */
+        enum class visibility {
+            invisible = 0,
+            normal = 1,
+            high = 2
+        };
+
+        /*!
+         * \brief The alignment enum
+         */
+        enum class alignment {
+            left,
+            right
+        };
+
+    private:
+        // the terminal's default colors, resp. colors not known
+        static constexpr int default_color = -1;
+        static constexpr int unknown_color = -2;
+        // attribute of a shown cell to be sent again
+        static constexpr short_type unknown_attr = -2;
+        // milliseconds waited for the replies to a query
+        static constexpr int reply_timeout = 500;
+
+        struct cell {
+            char_type ch;
+            short_type attr;
+
+            bool operator==(cell const& other) const noexcept {
+                return ch == other.ch && attr == other.attr;
+            }
+        };
+        using cells_type = std::vector<cell>;
+
+        struct colors {
+            int fg;
+            int bg;
+        };
+
+        termios saved_;
+        bool raw_;
+        rec_type r_;
+        short_type columns_;
+        short_type rows_;
+        cells_type cells_;          // drawn since the last refresh
+        cells_type shown_;          // shown by the terminal
+        colors colors_[max_attr];
+        short_type key_;
+        coord_type cursor_;         // drawing position
+        coord_type term_cursor_;    // terminal's cursor, X < 0 if not known
+        colors term_colors_;        // terminal's colors
+        visibility visibility_;
+        std::string out_;
+        ansi_events ev_;
+        frame_stats frame_;         // the frame being drawn
+        frame_stats last_;          // the last frame refreshed
+        int frames_;                // begin_frame() depth
+        bool pending_;              // refresh() asked within the frame
+        bool synchronized_;         // frames sent as synchronized updates
+
+    public:
+        ansi_console(ansi_console const&) = delete;
+        ansi_console& operator=(ansi_console const&) = delete;
+
+        ansi_console(coord_type size) :
+            raw_(false),
+            columns_(size.X),
+            rows_(size.Y),
+            key_(default_color),
+            cursor_(make_coord(0, 0)),
+            term_cursor_(make_coord(0, 0)),
+            term_colors_{ default_color, default_color },
+            visibility_(visibility::normal),
+            frames_(0),
+            pending_(false),
+            synchronized_(false)
+        {
+            // raw input: no echo, no line buffering, no signal keys
+            if (0 == ::tcgetattr(STDIN_FILENO, &saved_)) {
+                termios tio = saved_;
+                tio.c_iflag &= ~(IXON | ICRNL | BRKINT | INPCK | ISTRIP);
+                tio.c_lflag &= ~(ECHO | ICANON | ISIG | IEXTEN);
+                tio.c_cc[VMIN] = 0;
+                tio.c_cc[VTIME] = 0;
+                raw_ = (0 == ::tcsetattr(STDIN_FILENO, TCSAFLUSH, &tio));
+            }
+
+            winsize ws;
+            if (0 == ::ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) && ws.ws_col > 0 && ws.ws_row > 0) {
+                columns_ = static_cast<short_type>(ws.ws_col);
+                rows_ = static_cast<short_type>(ws.ws_row);
+            }
+            r_ = make_rec(0, 0, columns_, rows_);
+
+            for (auto& c : colors_) {
+                c = colors{ default_color, default_color };
+            }
+
+            // a cleared screen shows spaces in the default colors
+            const cell blank = { ' ', default_color };
+            cells_.assign(static_cast<size_type>(columns_) * rows_, blank);
+            shown_ = cells_;
+            out_.reserve(cells_.size() * 4);
+
+            // alternate screen, cleared, cursor at home
+            out_ += "\033[?1049h\033[0m\033[2J\033[H";
+            flush();
+
+            synchronized_ = raw_ && supports_mode(2026);
+            frame_.reset();
+        }
+
+        ~ansi_console() {
+            out_ += "\033[0m\033[?25h\033[?1049l";
+            flush();
+            if (raw_) {
+                ::tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_);
+            }
+        }
+
+        /*!
+         * \brief timeout
+         * \param tm
+         *      > 0 timeout
+         *      = 0 non-blocking
+         *      < 0 blocking
+         */
+        void set_timeout(int tm) {
+            ev_.set_timeout(tm);
+        }
+
+        events_type& get_events() noexcept {
+            return ev_;
+        }
+
+        /*!
+         * \brief get console window size
+         * \return
+         */
+        rec_type window() const noexcept {
+            return r_;
+        }
+
+        /*!
+         * \brief Set the console window size
+         * \note The terminal's size is used
+         */
+        void set_window(rec_type const& /*rec*/) {
+        }
+
+        /*!
+         * \brief get screen buffer size
+         * \return
+         */
+        coord_type size() const noexcept {
+            return make_coord(columns_, rows_);
+        }
+
+        /*!
+         * \brief resize screen buffer
+         * \note The terminal's size is used
+         */
+        void set_size(coord_type const& /*size*/) {
+        }
+
+        void add_attr(
+            int key,
+            color_type color /*= color::white*/,
+            color_type bcolor = color::black
+            )
+        {
+            assert(key >= 0 && key < max_attr);
+            const colors c = { static_cast<int>(color), static_cast<int>(bcolor) };
+            if (c.fg == colors_[key].fg && c.bg == colors_[key].bg) {
+                return;
+            }
+
+            colors_[key] = c;
+            // the cells shown with the old colors are sent again
+            for (auto& s : shown_) {
+                if (key == s.attr) {
+                    s.attr = unknown_attr;
+                }
+            }
+        }
+
+        /*
+         * \brief set the attribute used by the following print()s
+         * \param key
+         */
+        void set_attr(
+            int key
+            )
+        {
+            assert(key >= 0 && key < max_attr);
+            key_ = static_cast<short_type>(key);
+        }
+
+        /*!
+         * \brief read cursor state
+         */
+        visibility cursor_state() const {
+            return visibility_;
+        }
+
+        /*!
+         * \brief show/hide cursor (on the next refresh)
+         * \param visible
+         */
+        void show_cursor(visibility state = visibility::normal) {
+            visibility_ = state;
+            out_ += (visibility::invisible == state) ? "\033[?25l" : "\033[?25h";
+            ++frame_.escapes;
+        }
+
+        /*!
+         * \brief read current cursor position
+         * \return
+         */
+        coord_type cursor() const {
+            return cursor_;
+        }
+
+        /*
+         * \brief move screen cursor to specified position
+         * \param pos The new cursor position
+         */
+        void move_cursor(coord_type pos) {
+            cursor_ = pos;
+        }
+
+        /*
+         * \brief write a character to the terminal
+         * \param c
+         * \return
+         * \note
+         * The character is written at the cursor possion and the
+         * cursor position is moved to the right with one posision.
+         */
+        std::size_t print(char_type c) {
+            if (cursor_.X >= 0 && cursor_.X < columns_ && cursor_.Y >= 0 && cursor_.Y < rows_) {
+                cells_[index(cursor_.X, cursor_.Y)] = cell{ c, key_ };
+            }
+            ++cursor_.X;
+
+            return 1;
+        }
+
+        /*
+         * \brief write the string to the terminal
+         * \param str   String to be witten to terminal
+         * \param width Number of characters to be writte
+         *              (if the string is smaller, it will be padded with
+         *              spaces up to the required length).
+         *              If this value is -1, no padding is involved.
+         * \param align Text alignment, i.e. to the left or to
+         *              the right.
+         *
+         * \return
+         * \note
+         * The string is written at the cursor possion and the
+         * cursor position is moved to the right corresponding to
+         * the number characters in the string.
+         */
+        std::size_t print(
+            const char_type* str,
+            int width = -1,
+            alignment align = alignment::left
+            )
+        {
+            std::size_t length = std::strlen(str);
+            std::size_t pad = (width > 0 && static_cast<std::size_t>(width) > length) ? width - length : 0;
+
+            if (alignment::right == align) {
+                for (auto i = 0u; i < pad; ++i) {
+                    print(' ');
+                }
+            }
+            for (auto i = 0u; i < length; ++i) {
+                print(str[i]);
+            }
+            if (alignment::left == align) {
+                for (auto i = 0u; i < pad; ++i) {
+                    print(' ');
+                }
+            }
+
+            return length + pad;
+        }
+
+        /*
+         * \brief write the cells that changed since the last refresh
+         *        to the terminal, with a single write
+         */
+        void refresh() {
+            ++frame_.refreshes;
+            if (frames_ > 0) {
+                // sent by end_frame()
+                pending_ = true;
+                return;
+            }
+
+            present();
+        }
+
+        /*!
+         * \brief starts a frame, the following refresh()es are sent
+         *        together by end_frame(); the frames can be nested
+         */
+        void begin_frame() noexcept {
+            ++frames_;
+        }
+
+        /*!
+         * \brief ends a frame, sends it if a refresh() was asked for
+         */
+        void end_frame() {
+            assert(frames_ > 0);
+            if (0 == --frames_ && pending_) {
+                pending_ = false;
+                present();
+            }
+        }
+
+        /*!
+         * \brief true if the frames are sent as synchronized updates
+         */
+        bool synchronized() const noexcept {
+            return synchronized_;
+        }
+
+        /*!
+         * \brief sends (or not) the frames as synchronized updates, e.g. if
+         *        the terminal supports them but does not answer the query
+         */
+        void set_synchronized(bool on) noexcept {
+            synchronized_ = on;
+        }
+
+        /*!
+         * \brief what was written for the last frame (up to the last refresh)
+         */
+        frame_stats const& stats() const noexcept {
+            return last_;
+        }
+
+        /*
+         * \brief clear a termina area
+         * \param top_left
+         * \param bottom_right
+         */
+        void clear_area(coord_type top_left, coord_type bottom_right) {
+            coord_type pt = top_left;
+            auto width = (bottom_right.X - top_left.X);
+            auto height = (bottom_right.Y - top_left.Y);
+
+            for (auto j = 0; j < height; ++j) {
+                move_cursor(pt);
+                for (auto i = 0; i < width; ++i) {
+                    print(' ');
+                }
+
+                ++pt.Y;
+            }
+        }
+
+        /*!
+         * \brief set console title (on the next refresh)
+         * \param title
+         */
+        void set_title(char_type const* title) {
+            out_ += "\033]0;";
+            out_ += title;
+            out_ += '\007';
+            ++frame_.escapes;
+        }
+
+    private:
+        /*!
+         * \brief writes the cells that changed since the last frame
+         */
+        void present() {
+            static const char begin_sync[] = "\033[?2026h";
+            static const char end_sync[] = "\033[?2026l";
+
+            const std::size_t mark = out_.size();
+            if (synchronized_) {
+                out_ += begin_sync;
+            }
+            const std::size_t first = out_.size();
+
+            for (short_type y = 0; y < rows_; ++y) {
+                for (short_type x = 0; x < columns_; ++x) {
+                    std::size_t i = index(x, y);
+                    if (cells_[i] == shown_[i]) {
+                        continue;
+                    }
+
+                    move_to(x, y);
+                    set_colors(cells_[i].attr);
+                    out_ += cells_[i].ch;
+                    shown_[i] = cells_[i];
+                    advance();
+                }
+            }
+
+            if (synchronized_) {
+                if (out_.size() == first) {
+                    // nothing changed
+                    out_.resize(mark);
+                }
+                else {
+                    out_ += end_sync;
+                    frame_.escapes += 2;
+                }
+            }
+
+            flush();
+            last_ = frame_;
+            frame_.reset();
+        }
+
+        std::size_t index(short_type x, short_type y) const noexcept {
+            return static_cast<std::size_t>(y) * columns_ + x;
+        }
+
+        void append(int n) {
+            char tmp[12];
+            int i = 0;
+            do {
+                tmp[i++] = static_cast<char>('0' + n % 10);
+                n /= 10;
+            } while (n > 0);
+            while (i > 0) {
+                out_ += tmp[--i];
+            }
+        }
+
+        static int digits(int n) noexcept {
+            return (n < 10) ? 1 : (n < 100) ? 2 : (n < 1000) ? 3 : (n < 10000) ? 4 : 5;
+        }
+
+        /*!
+         * \brief the terminal's cursor moved right after a character
+         */
+        void advance() noexcept {
+            if (++term_cursor_.X >= columns_) {
+                // pending wrap, where the cursor is depends on the terminal
+                term_cursor_.X = -1;
+            }
+        }
+
+        /*!
+         * \brief moves the terminal's cursor to (x, y) with the shortest
+         *        sequence: characters already shown, a relative move or
+         *        an absolute one
+         */
+        void move_to(short_type x, short_type y) {
+            const short_type tx = term_cursor_.X;
+            const short_type ty = term_cursor_.Y;
+            if (tx == x && ty == y) {
+                return;
+            }
+
+            if (tx >= 0 && ty == y && x > tx) {
+                const int gap = x - tx;
+                // the cells in between are unchanged, writing them again is
+                // shorter than a move if they have the current colors
+                if (gap < 3 + digits(gap) && same_colors(tx, x, y)) {
+                    for (auto i = tx; i < x; ++i) {
+                        out_ += cells_[index(i, y)].ch;
+                    }
+                }
+                else {
+                    relative_move(gap, 'C');
+                }
+            }
+            else if (tx >= 0 && ty == y && 0 == x) {
+                out_ += '\r';
+                ++frame_.moves;
+            }
+            else if (tx >= 0 && ty == y) {
+                relative_move(tx - x, 'D');
+            }
+            else if (tx == x && y > ty) {
+                relative_move(y - ty, 'B');
+            }
+            else if (tx == x) {
+                relative_move(ty - y, 'A');
+            }
+            else {
+                out_ += "\033[";
+                ++frame_.escapes;
+                ++frame_.moves;
+                append(y + 1);
+                if (x > 0) {
+                    out_ += ';';
+                    append(x + 1);
+                }
+                out_ += 'H';
+            }
+
+            term_cursor_ = make_coord(x, y);
+        }
+
+        void relative_move(int n, char cmd) {
+            out_ += "\033[";
+            ++frame_.escapes;
+            ++frame_.moves;
+            if (n > 1) {
+                append(n);
+            }
+            out_ += cmd;
+        }
+
+        bool same_colors(short_type first, short_type last, short_type y) const noexcept {
+            for (auto i = first; i < last; ++i) {
+                colors c = colors_of(cells_[index(i, y)].attr);
+                if (c.fg != term_colors_.fg || c.bg != term_colors_.bg) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        colors colors_of(short_type attr) const noexcept {
+            return (attr < 0) ? colors{ default_color, default_color } : colors_[attr];
+        }
+
+        /*!
+         * \brief selects the colors of the attribute, only the ones that
+         *        differ from the terminal's current colors
+         */
+        void set_colors(short_type attr) {
+            colors c = colors_of(attr);
+            if (c.fg == term_colors_.fg && c.bg == term_colors_.bg) {
+                return;
+            }
+
+            out_ += "\033[";
+            ++frame_.escapes;
+            ++frame_.attributes;
+            if (default_color == c.fg || default_color == c.bg) {
+                // back to the defaults, then the other color (if any)
+                out_ += '0';
+                term_colors_ = colors{ default_color, default_color };
+                if (default_color != c.fg) {
+                    out_ += ";3";
+                    append(c.fg);
+                }
+                if (default_color != c.bg) {
+                    out_ += ";4";
+                    append(c.bg);
+                }
+            }
+            else if (c.fg != term_colors_.fg && c.bg != term_colors_.bg) {
+                out_ += '3';
+                append(c.fg);
+                out_ += ";4";
+                append(c.bg);
+            }
+            else if (c.fg != term_colors_.fg) {
+                out_ += '3';
+                append(c.fg);
+            }
+            else {
+                out_ += '4';
+                append(c.bg);
+            }
+            out_ += 'm';
+            term_colors_ = c;
+        }
+
+        /*!
+         * \brief writes the pending output
+         */
+        void flush() {
+            const char* data = out_.data();
+            std::size_t size = out_.size();
+            while (size > 0) {
+                ssize_t n = ::write(STDOUT_FILENO, data, size);
+                if (n < 0) {
+                    if (EINTR == errno) {
+                        continue;
+                    }
+                    // the terminal state is not known any more
+                    term_cursor_.X = -1;
+                    term_colors_ = colors{ unknown_color, unknown_color };
+                    break;
+                }
+                data += n;
+                size -= static_cast<std::size_t>(n);
+                frame_.bytes += static_cast<std::size_t>(n);
+            }
+            out_.clear();
+        }
+
+        /*!
+         * \brief asks the terminal if it supports a DEC private mode
+         *        (DECRQM); a terminal that does not know the query does
+         *        not answer it, the DA1 query after it tells when to stop
+         *        waiting (a reply later than that is dropped by read())
+         */
+        bool supports_mode(int mode) {
+            out_ += "\033[?";
+            append(mode);
+            out_ += "$p\033[c";
+            flush();
+
+            // 1 set, 2 reset, 3 permanently set (0 unknown, 4 permanently reset)
+            int value = ev_.mode_reply(mode, reply_timeout);
+            return 1 == value || 2 == value || 3 == value;
+        }
+    };
+
+} // namespace xtd
+
+#endif // LINUX_ANSI_H__
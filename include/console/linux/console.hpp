@@ -8,84 +8,45 @@
 #define LINUX_CONSOLE_H__
 
 #include "console/types.hpp"
+#include "events.hpp"
+#include "console/stats.hpp"
 #include <ncurses.h>
 #include <locale.h>
+#include <poll.h>
+#include <unistd.h>
 #include <utility>
-#include <map>
 #include <string>
 #include <cassert>
 
 namespace xtd {
 
-    ///
-    /// \brief generic color code(s)
-    ///
-    enum class color {
-        black = COLOR_BLACK,
-        blue = COLOR_BLUE,
-        green = COLOR_GREEN,
-        cyan = COLOR_CYAN,
-        red = COLOR_RED,
-        magenta = COLOR_MAGENTA,
-        yellow = COLOR_YELLOW,
-        white = COLOR_WHITE,
-//        DARKBLUE,
-//        DARKGREEN,
-//        DARKCYAN,
-//        DARKRED,
-//        DARKMAGENTA,
-//        DARKYELLOW,
-//        DARKGRAY,
-//        GRAY,
-    };
-
     /*!
      * \brief events structure
      */
-    struct events {
-
-        // event types
-        enum class kind {
-            none,
-            key,
-            mouse,
-            resize,
-        };
+    struct events :
+        public event_types
+    {
+    private:
+        // written by interrupt(), read end polled by wait()
+        int wake_[2];
 
-        // mouse buttons
-        enum class button {
-            none,
-            left,
-            right,
-            middle,
-        };
+    public:
+        events() {
+            if (0 != ::pipe(wake_)) {
+                wake_[0] = wake_[1] = -1;
+            }
+        }
 
-        enum class state {
-            none,
-            pressed,
-            released
-        };
+        events(events const&) = delete;
+        events& operator=(events const&) = delete;
 
-        struct event {
-            kind type;
-            union {
-                int key;
-                struct {
-                    int x;
-                    int y;
-                    button btn;
-                    state st;
-                } mouse;
-            };
-
-            event() :
-                type(kind::none)
-            {
+        ~events() {
+            if (wake_[0] >= 0) {
+                ::close(wake_[0]);
+                ::close(wake_[1]);
             }
-        };
-        using event_type = struct event;
+        }
 
-    public:
         /*!
          * \brief Read the next available console event
          * \return
@@ -145,6 +106,30 @@ namespace xtd {
 
             return ev;
         }
+
+        /*!
+         * \brief waits for input, without reading it
+         * \param tm milliseconds
+         *      > 0 timeout
+         *      = 0 does not wait
+         *      < 0 until there is input
+         * \return true if there is input, false after interrupt()
+         */
+        bool wait(int tm) const noexcept {
+            pollfd fds[2] = { { STDIN_FILENO, POLLIN, 0 }, { wake_[0], POLLIN, 0 } };
+            return ::poll(fds, 2, tm) > 0 && 0 == (fds[1].revents & POLLIN) && 0 != (fds[0].revents & POLLIN);
+        }
+
+        /*!
+         * \brief makes the current and the next wait() return false at once
+         *        (thread safe)
+         */
+        void interrupt() noexcept {
+            char c = 0;
+            if (wake_[1] >= 0 && 1 != ::write(wake_[1], &c, 1)) {
+                // nothing to do, the pipe is not full with one byte
+            }
+        }
     };
 
 
@@ -153,6 +138,7 @@ namespace xtd {
      */
     struct console{
         using char_type = traits::char_type;
+        using events_type = events;
 //        using color_type = short_type;
         using color_type = color;
         using pair_type = std::pair<color_type, color_type>;
@@ -174,22 +160,35 @@ namespace xtd {
             right
         };
 
-    private:
-        using colors_type = std::map<int, pair_type>;
+        // the attributes are the keys 0 .. max_attr - 1
+        static constexpr int max_attr = 256;
 
+    private:
         rec_type r_;
         color_type color_;
         color_type background_;
-        colors_type colors_;
+        pair_type colors_[max_attr];
+        // curses attribute of each key, resolved once by add_attr()
+        attr_t attrs_[max_attr];
         int key_;
         events ev_;
+        frame_stats frame_;
+        frame_stats last_;
+        int frames_;
+        bool pending_;
 
     public:
         console(coord_type) :
             color_(color::white),
             background_(color::black),
-            key_(-1)
+            key_(-1),
+            frames_(0),
+            pending_(false)
         {
+            for (auto& a : attrs_) {
+                a = A_NORMAL;
+            }
+
             /* make sure UTF8 */
             ::setlocale(LC_ALL, "");
 //            ::setlocale(LC_ALL, "en_US.UTF-8");
@@ -305,32 +304,29 @@ namespace xtd {
             color_type bcolor = color::black
             )
         {
-            colors_[key] = std::pair<color_type, color_type>(color, bcolor);
+            assert(key >= 0 && key < max_attr);
+            colors_[key] = pair_type(color, bcolor);
             ::init_pair(
                 key,
                 static_cast<int>(color),
                 static_cast<int>(bcolor)
                 );
+            attrs_[key] = COLOR_PAIR(key);
         }
 
         /*
-         * \brief
+         * \brief set the attribute used by the following print()s
          * \param key
          */
         void set_attr(
             int key
             )
         {
-            colors_type::const_iterator it = colors_.find(key);
-            if (it != colors_.end()) {
-                if (key_ >= 0) {
-                    ::attroff(COLOR_PAIR(key_));
-                }
-
-                key_ = (*it).first;
-                ::attron(COLOR_PAIR(key_));
-            } else {
-                assert(false);
+            assert(key >= 0 && key < max_attr);
+            if (key != key_) {
+                key_ = key;
+                ::attrset(attrs_[key]);
+                ++frame_.attributes;
             }
         }
 
@@ -370,6 +366,7 @@ namespace xtd {
          */
         void move_cursor(coord_type pos) {
             ::move(pos.Y, pos.X);
+            ++frame_.moves;
         }
 
         /*
@@ -383,6 +380,7 @@ namespace xtd {
         std::size_t print(char_type c) {
             coord_type pos = cursor();
             mvaddch(pos.Y, pos.X, c);
+            ++frame_.bytes;
 
             return 1;
         }
@@ -426,6 +424,7 @@ namespace xtd {
             }
 
             mvaddstr(pos.Y, pos.X, tmp.c_str());
+            frame_.bytes += tmp.length();
 //            mvprintw(str);
             return tmp.length();
         }
@@ -434,7 +433,45 @@ namespace xtd {
          * \brief write the internal buffer content to the terminal
          */
         void refresh() {
+            ++frame_.refreshes;
+            if (frames_ > 0) {
+                // copied to the screen by end_frame()
+                ::wnoutrefresh(stdscr);
+                pending_ = true;
+                return;
+            }
+
             ::refresh();
+            last_ = frame_;
+            frame_.reset();
+        }
+
+        /*!
+         * \brief the calls of the last frame (up to the last refresh)
+         */
+        frame_stats const& stats() const noexcept {
+            return last_;
+        }
+
+        /*!
+         * \brief starts a frame, the following refresh()es only update
+         *        curses' virtual screen; the frames can be nested
+         */
+        void begin_frame() noexcept {
+            ++frames_;
+        }
+
+        /*!
+         * \brief ends a frame, updates the terminal once
+         */
+        void end_frame() {
+            assert(frames_ > 0);
+            if (0 == --frames_ && pending_) {
+                pending_ = false;
+                ::doupdate();
+                last_ = frame_;
+                frame_.reset();
+            }
         }
 
         /*
@@ -0,0 +1,90 @@
+
+/*!
+ * \brief C++ console framework (Linux), types shared by the console backends
+ * \file  events.hpp
+ */
+
+#if !defined(LINUX_EVENTS_H__)
+#define LINUX_EVENTS_H__
+
+namespace xtd {
+
+    ///
+    /// \brief generic color code(s), the ANSI color numbers
+    ///        (the same values as curses' COLOR_*)
+    ///
+    enum class color {
+        black = 0,
+        blue = 4,
+        green = 2,
+        cyan = 6,
+        red = 1,
+        magenta = 5,
+        yellow = 3,
+        white = 7,
+        // only the 8 basic colors are used, the dark ones are
+        // the basic colors themselves (same names as on Windows)
+        darkblue = blue,
+        darkgreen = green,
+        darkcyan = cyan,
+        darkred = red,
+        darkmagenta = magenta,
+        darkyellow = yellow,
+        darkgray = white,
+        gray = white,
+    };
+
+    /*!
+     * \brief event types, common to all the Linux events readers
+     */
+    struct event_types {
+
+        // event types
+        enum class kind {
+            none,
+            key,
+            key_up,
+            mouse,
+            resize,
+        };
+
+        // a terminal only sends the keys pressed (and repeated), no key_up
+        static constexpr bool key_releases = false;
+
+        // mouse buttons
+        enum class button {
+            none,
+            left,
+            right,
+            middle,
+        };
+
+        enum class state {
+            none,
+            pressed,
+            released
+        };
+
+        struct event {
+            kind type;
+            union {
+                int key;
+                struct {
+                    int x;
+                    int y;
+                    button btn;
+                    state st;
+                } mouse;
+            };
+
+            event() :
+                type(kind::none)
+            {
+            }
+        };
+        using event_type = struct event;
+    };
+
+} // namespace xtd
+
+#endif // LINUX_EVENTS_H__
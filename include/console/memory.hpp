@@ -0,0 +1,373 @@
+
+/*!
+ * \brief C++ console framework, in-memory console
+ * \file  memory.hpp
+ *
+ * A console that draws into a grid of (glyph, attribute) cells in memory and
+ * never touches a terminal, e.g. to run and measure the drawing code without
+ * a terminal, or to compare what was drawn cell by cell.
+ */
+
+#if !defined(MEMORY_CONSOLE_H__)
+#define MEMORY_CONSOLE_H__
+
+#include "console/types.hpp"
+#include "console/color.hpp"
+#include "console/stats.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+namespace xtd {
+
+    /*
+     * \brief console drawing into memory
+     */
+    struct memory_console {
+        using char_type = traits::char_type;
+        using color_type = color;
+        using pair_type = std::pair<color_type, color_type>;
+
+        // the attributes are the keys 0 .. max_attr - 1
+        static constexpr int max_attr = 256;
+
+        /*!
+         * \brief The visibility enum
+         */
+        enum class visibility {
+            invisible = 0,
+            normal = 1,
+            high = 2
+        };
+
+        /*!
+         * \brief The alignment enum
+         */
+        enum class alignment {
+            left,
+            right
+        };
+
+        /*!
+         * \brief a character cell: the glyph and the attribute (key) it
+         *        was printed with
+         */
+        struct cell {
+            char_type glyph;
+            short_type attr;
+
+            bool operator==(cell const& other) const noexcept {
+                return glyph == other.glyph && attr == other.attr;
+            }
+
+            bool operator!=(cell const& other) const noexcept {
+                return !(*this == other);
+            }
+        };
+        using grid_type = std::vector<cell>;
+
+    private:
+        coord_type size_;
+        grid_type grid_;
+        pair_type colors_[max_attr];
+        short_type key_;
+        coord_type cursor_;
+        visibility visibility_;
+        std::size_t refreshes_;
+        frame_stats frame_;
+        frame_stats last_;
+        int frames_;
+        bool pending_;
+
+    public:
+        memory_console(coord_type size) :
+            size_(size),
+            key_(0),
+            cursor_(make_coord(0, 0)),
+            visibility_(visibility::normal),
+            refreshes_(0),
+            frames_(0),
+            pending_(false)
+        {
+            for (auto& c : colors_) {
+                c = pair_type(color::white, color::black);
+            }
+            set_size(size);
+        }
+
+        /*!
+         * \brief timeout
+         * \note There is no input
+         */
+        void set_timeout(int /*tm*/) noexcept {
+        }
+
+        /*!
+         * \brief get console window size
+         * \return
+         */
+        rec_type window() const noexcept {
+            return make_rec(0, 0, size_.X, size_.Y);
+        }
+
+        /*!
+         * \brief Set the console window size
+         */
+        void set_window(rec_type const& /*rec*/) noexcept {
+        }
+
+        /*!
+         * \brief get screen buffer size
+         * \return
+         */
+        coord_type size() const noexcept {
+            return size_;
+        }
+
+        /*!
+         * \brief resize screen buffer, the content is cleared
+         * \param size The new screen buffer size
+         */
+        void set_size(coord_type const& size) {
+            size_ = size;
+            const cell blank = { ' ', 0 };
+            grid_.assign(static_cast<std::size_t>(size_.X) * size_.Y, blank);
+        }
+
+        void add_attr(
+            int key,
+            color_type color /*= color::white*/,
+            color_type bcolor = color::black
+            )
+        {
+            assert(key >= 0 && key < max_attr);
+            colors_[key] = pair_type(color, bcolor);
+        }
+
+        /*
+         * \brief set the attribute used by the following print()s
+         * \param key
+         */
+        void set_attr(
+            int key
+            )
+        {
+            assert(key >= 0 && key < max_attr);
+            key_ = static_cast<short_type>(key);
+            ++frame_.attributes;
+        }
+
+        /*!
+         * \brief the colors of an attribute
+         */
+        pair_type attr(int key) const {
+            assert(key >= 0 && key < max_attr);
+            return colors_[key];
+        }
+
+        visibility cursor_state() const noexcept {
+            return visibility_;
+        }
+
+        void show_cursor(visibility state = visibility::normal) noexcept {
+            visibility_ = state;
+        }
+
+        /*!
+         * \brief read current cursor position
+         * \return
+         */
+        coord_type cursor() const noexcept {
+            return cursor_;
+        }
+
+        /*
+         * \brief move screen cursor to specified position
+         * \param pos The new cursor position
+         */
+        void move_cursor(coord_type pos) noexcept {
+            cursor_ = pos;
+            ++frame_.moves;
+        }
+
+        /*
+         * \brief write a character at the cursor position (the characters
+         *        out of the grid are dropped) and moves the cursor to the
+         *        right with one position
+         * \param c
+         * \return
+         */
+        std::size_t print(char_type c) {
+            if (cursor_.X >= 0 && cursor_.X < size_.X && cursor_.Y >= 0 && cursor_.Y < size_.Y) {
+                grid_[index(cursor_.X, cursor_.Y)] = cell{ c, key_ };
+            }
+            ++cursor_.X;
+            ++frame_.bytes;
+
+            return 1;
+        }
+
+        /*
+         * \brief write the string at the cursor position
+         * \param str   String to be witten
+         * \param width Number of characters to be writte
+         *              (if the string is smaller, it will be padded with
+         *              spaces up to the required length).
+         *              If this value is -1, no padding is involved.
+         * \param align Text alignment, i.e. to the left or to
+         *              the right.
+         * \return
+         */
+        std::size_t print(
+            const char_type* str,
+            int width = -1,
+            alignment align = alignment::left
+            )
+        {
+            std::size_t length = 0;
+            while (str[length] != 0) {
+                ++length;
+            }
+            std::size_t pad = (width > 0 && static_cast<std::size_t>(width) > length) ? width - length : 0;
+
+            if (alignment::right == align) {
+                for (auto i = 0u; i < pad; ++i) {
+                    print(' ');
+                }
+            }
+            for (auto i = 0u; i < length; ++i) {
+                print(str[i]);
+            }
+            if (alignment::left == align) {
+                for (auto i = 0u; i < pad; ++i) {
+                    print(' ');
+                }
+            }
+
+            return length + pad;
+        }
+
+        /*
+         * \brief counts the frames, there is nothing to write
+         */
+        void refresh() noexcept {
+            ++frame_.refreshes;
+            if (frames_ > 0) {
+                pending_ = true;
+                return;
+            }
+
+            end_refresh();
+        }
+
+        /*!
+         * \brief starts a frame, the following refresh()es count as one
+         *        at end_frame(); the frames can be nested
+         */
+        void begin_frame() noexcept {
+            ++frames_;
+        }
+
+        void end_frame() noexcept {
+            assert(frames_ > 0);
+            if (0 == --frames_ && pending_) {
+                pending_ = false;
+                end_refresh();
+            }
+        }
+
+        /*!
+         * \brief the calls of the last frame (up to the last refresh)
+         */
+        frame_stats const& stats() const noexcept {
+            return last_;
+        }
+
+        /*
+         * \brief clear an area
+         * \param top_left
+         * \param bottom_right
+         */
+        void clear_area(coord_type top_left, coord_type bottom_right) {
+            coord_type pt = top_left;
+            auto width = (bottom_right.X - top_left.X);
+            auto height = (bottom_right.Y - top_left.Y);
+
+            for (auto j = 0; j < height; ++j) {
+                move_cursor(pt);
+                for (auto i = 0; i < width; ++i) {
+                    print(' ');
+                }
+
+                ++pt.Y;
+            }
+        }
+
+        void set_title(char_type const* /*title*/) const noexcept {
+        }
+
+        /*!
+         * \brief the cells, row after row (size().X cells per row)
+         */
+        grid_type const& grid() const noexcept {
+            return grid_;
+        }
+
+        /*!
+         * \brief the cell at (x, y)
+         */
+        cell const& at(short_type x, short_type y) const {
+            assert(x >= 0 && x < size_.X && y >= 0 && y < size_.Y);
+            return grid_[index(x, y)];
+        }
+
+        /*!
+         * \brief number of frames refreshed (the refresh() calls out of
+         *        begin_frame() / end_frame() and the frames refreshed)
+         */
+        std::size_t refreshes() const noexcept {
+            return refreshes_;
+        }
+
+        /*!
+         * \brief FNV-1a hash of the grid (glyphs and attributes), the same
+         *        grid gives the same hash on every platform (a glyph is
+         *        hashed as its unsigned code in 4 bytes, whatever the size
+         *        of char_type)
+         */
+        std::uint64_t hash() const noexcept {
+            std::uint64_t h = 0xCBF29CE484222325ull;
+            auto feed = [&h](std::uint32_t value, int bytes) {
+                for (auto i = 0; i < bytes; ++i) {
+                    h ^= (value >> (8 * i)) & 0xFF;
+                    h *= 0x100000001B3ull;
+                }
+            };
+
+            feed(static_cast<std::uint16_t>(size_.X), 2);
+            feed(static_cast<std::uint16_t>(size_.Y), 2);
+            for (auto const& c : grid_) {
+                feed(static_cast<std::uint32_t>(static_cast<typename std::make_unsigned<char_type>::type>(c.glyph)), 4);
+                feed(static_cast<std::uint16_t>(c.attr), 2);
+            }
+            return h;
+        }
+
+    private:
+        void end_refresh() noexcept {
+            ++refreshes_;
+            last_ = frame_;
+            frame_.reset();
+        }
+
+        std::size_t index(short_type x, short_type y) const noexcept {
+            return static_cast<std::size_t>(y) * size_.X + x;
+        }
+    };
+
+} // namespace xtd
+
+#endif // MEMORY_CONSOLE_H__
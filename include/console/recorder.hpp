@@ -0,0 +1,176 @@
+
+/*!
+ * \brief C++ console framework, a console recording the drawing to a stream
+ * \file  recorder.hpp
+ *
+ * Every drawing call is written as one line of text:
+ *      a key fg bg     add_attr
+ *      s key           set_attr
+ *      m x y           move_cursor
+ *      p text          print (consecutive prints are joined)
+ *      c x y x y       clear_area
+ *      r               refresh
+ *
+ * Used with tee (e.g. the terminal and a file) to record a session.
+ */
+
+#if !defined(RECORDER_H__)
+#define RECORDER_H__
+
+#include "console/types.hpp"
+#include "console/color.hpp"
+
+#include <ostream>
+#include <string>
+
+namespace xtd {
+
+    /*
+     * \brief console writing the drawing calls to a stream
+     */
+    struct recorder {
+        using char_type = traits::char_type;
+        using color_type = color;
+
+        /*!
+         * \brief The visibility enum
+         */
+        enum class visibility {
+            invisible = 0,
+            normal = 1,
+            high = 2
+        };
+
+        /*!
+         * \brief The alignment enum
+         */
+        enum class alignment {
+            left,
+            right
+        };
+
+    private:
+        std::ostream& out_;
+        coord_type size_;
+        coord_type cursor_;
+        visibility visibility_;
+        std::string text_;  // printed, not written yet
+
+    public:
+        recorder(std::ostream& out, coord_type size) :
+            out_(out),
+            size_(size),
+            cursor_(make_coord(0, 0)),
+            visibility_(visibility::normal)
+        {
+        }
+
+        ~recorder() {
+            flush_text();
+            out_.flush();
+        }
+
+        void set_timeout(int /*tm*/) noexcept {
+        }
+
+        rec_type window() const noexcept {
+            return make_rec(0, 0, size_.X, size_.Y);
+        }
+
+        coord_type size() const noexcept {
+            return size_;
+        }
+
+        void add_attr(
+            int key,
+            color_type color /*= color::white*/,
+            color_type bcolor = color::black
+            )
+        {
+            flush_text();
+            out_ << "a " << key << ' ' << static_cast<int>(color) << ' ' << static_cast<int>(bcolor) << '\n';
+        }
+
+        void set_attr(
+            int key
+            )
+        {
+            flush_text();
+            out_ << "s " << key << '\n';
+        }
+
+        visibility cursor_state() const noexcept {
+            return visibility_;
+        }
+
+        void show_cursor(visibility state = visibility::normal) noexcept {
+            visibility_ = state;
+        }
+
+        coord_type cursor() const noexcept {
+            return cursor_;
+        }
+
+        void move_cursor(coord_type pos) {
+            flush_text();
+            cursor_ = pos;
+            out_ << "m " << pos.X << ' ' << pos.Y << '\n';
+        }
+
+        std::size_t print(char_type c) {
+            text_ += static_cast<char>(c);
+            ++cursor_.X;
+            return 1;
+        }
+
+        std::size_t print(
+            const char_type* str,
+            int width = -1,
+            alignment align = alignment::left
+            )
+        {
+            std::size_t length = 0;
+            while (str[length] != 0) {
+                ++length;
+            }
+            std::size_t pad = (width > 0 && static_cast<std::size_t>(width) > length) ? width - length : 0;
+
+            if (alignment::right == align) {
+                text_.append(pad, ' ');
+            }
+            for (auto i = 0u; i < length; ++i) {
+                text_ += static_cast<char>(str[i]);
+            }
+            if (alignment::left == align) {
+                text_.append(pad, ' ');
+            }
+
+            cursor_.X = static_cast<short_type>(cursor_.X + length + pad);
+            return length + pad;
+        }
+
+        void refresh() {
+            flush_text();
+            out_ << "r\n";
+        }
+
+        void clear_area(coord_type top_left, coord_type bottom_right) {
+            flush_text();
+            out_ << "c " << top_left.X << ' ' << top_left.Y << ' ' << bottom_right.X << ' ' << bottom_right.Y << '\n';
+        }
+
+        void set_title(char_type const* /*title*/) const noexcept {
+        }
+
+    private:
+        void flush_text() {
+            if (!text_.empty()) {
+                out_ << "p " << text_ << '\n';
+                text_.clear();
+            }
+        }
+    };
+
+} // namespace xtd
+
+#endif // RECORDER_H__
@@ -0,0 +1,47 @@
+
+/*!
+ * \brief C++ console framework, output statistics
+ * \file  stats.hpp
+ */
+
+#if !defined(STATS_H__)
+#define STATS_H__
+
+#include <cstddef>
+
+namespace xtd {
+
+    /*!
+     * \brief what a console sent to the terminal for one frame, i.e.
+     *        between two refresh() calls
+     *
+     * \note
+     * The ANSI console counts the bytes and escape sequences it writes.
+     * The curses and memory consoles count the calls (the characters printed,
+     * the cursor moves and the attribute changes asked for), curses itself
+     * decides what is written; they do not count escape sequences.
+     */
+    struct frame_stats {
+        std::size_t bytes = 0;          // bytes written (characters printed)
+        std::size_t escapes = 0;        // escape sequences written
+        std::size_t moves = 0;          // cursor moves
+        std::size_t attributes = 0;     // attribute (color) switches
+        std::size_t refreshes = 0;      // refresh() calls
+
+        void reset() noexcept {
+            *this = frame_stats();
+        }
+
+        frame_stats& operator+=(frame_stats const& other) noexcept {
+            bytes += other.bytes;
+            escapes += other.escapes;
+            moves += other.moves;
+            attributes += other.attributes;
+            refreshes += other.refreshes;
+            return *this;
+        }
+    };
+
+} // namespace xtd
+
+#endif // STATS_H__
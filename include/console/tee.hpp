@@ -0,0 +1,169 @@
+
+/*!
+ * \brief C++ console framework, a console drawing on two consoles
+ * \file  tee.hpp
+ */
+
+#if !defined(TEE_H__)
+#define TEE_H__
+
+#include "console/types.hpp"
+#include "backend.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace xtd {
+
+    /*
+     * \brief draws on two consoles (e.g. the terminal and a recorder);
+     *        the cursor, the size and the input are the first one's
+     */
+    template <
+        typename A,
+        typename B
+        >
+    struct tee {
+        using first_type = A;
+        using second_type = B;
+        using char_type = typename A::char_type;
+        using color_type = typename A::color_type;
+        using visibility = typename A::visibility;
+        using alignment = typename A::alignment;
+
+        static_assert(is_console_backend<A>::value && is_console_backend<B>::value, "tee needs two console backends");
+        static_assert(std::is_same<char_type, typename B::char_type>::value, "the consoles must use the same characters");
+        static_assert(std::is_same<color_type, typename B::color_type>::value, "the consoles must use the same colors");
+
+    private:
+        first_type& a_;
+        second_type& b_;
+
+    public:
+        tee(first_type& a, second_type& b) :
+            a_(a),
+            b_(b)
+        {
+        }
+
+        first_type& first() noexcept {
+            return a_;
+        }
+
+        second_type& second() noexcept {
+            return b_;
+        }
+
+        template <typename T = A>
+        typename T::events_type& get_events() noexcept {
+            return a_.get_events();
+        }
+
+        void set_timeout(int tm) {
+            a_.set_timeout(tm);
+        }
+
+        rec_type window() const {
+            return a_.window();
+        }
+
+        coord_type size() const {
+            return a_.size();
+        }
+
+        void add_attr(
+            int key,
+            color_type color,
+            color_type bcolor = color_type::black
+            )
+        {
+            a_.add_attr(key, color, bcolor);
+            b_.add_attr(key, color, bcolor);
+        }
+
+        void set_attr(int key) {
+            a_.set_attr(key);
+            b_.set_attr(key);
+        }
+
+        visibility cursor_state() const {
+            return a_.cursor_state();
+        }
+
+        void show_cursor(visibility state = visibility::normal) {
+            a_.show_cursor(state);
+            b_.show_cursor(static_cast<typename B::visibility>(static_cast<int>(state)));
+        }
+
+        coord_type cursor() const {
+            return a_.cursor();
+        }
+
+        void move_cursor(coord_type pos) {
+            a_.move_cursor(pos);
+            b_.move_cursor(pos);
+        }
+
+        std::size_t print(char_type c) {
+            b_.print(c);
+            return a_.print(c);
+        }
+
+        std::size_t print(
+            const char_type* str,
+            int width = -1,
+            alignment align = alignment::left
+            )
+        {
+            b_.print(str, width, static_cast<typename B::alignment>(static_cast<int>(align)));
+            return a_.print(str, width, align);
+        }
+
+        void refresh() {
+            a_.refresh();
+            b_.refresh();
+        }
+
+        void begin_frame() {
+            frame_begin(a_);
+            frame_begin(b_);
+        }
+
+        void end_frame() {
+            frame_end(a_);
+            frame_end(b_);
+        }
+
+        void clear_area(coord_type top_left, coord_type bottom_right) {
+            a_.clear_area(top_left, bottom_right);
+            b_.clear_area(top_left, bottom_right);
+        }
+
+        void set_title(char_type const* title) {
+            a_.set_title(title);
+            b_.set_title(title);
+        }
+
+        /*!
+         * \brief the first console's statistics of the last frame
+         */
+        template <typename T = A>
+        auto stats() const noexcept -> decltype(std::declval<T const&>().stats()) {
+            return static_cast<T const&>(a_).stats();
+        }
+    };
+
+    /*!
+     * \brief make_tee
+     * \return a console drawing on a and b
+     */
+    template <
+        typename A,
+        typename B
+        >
+    tee<A, B> make_tee(A& a, B& b) {
+        return tee<A, B>(a, b);
+    }
+
+} // namespace xtd
+
+#endif // TEE_H__
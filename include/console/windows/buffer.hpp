@@ -146,6 +146,14 @@ namespace xtd {
             attr_ = tmp.get_attr();
         }
 
+        ///
+        /// \brief set_attr
+        /// \param value colors of the next cells printed
+        ///
+        void set_attr(attr::value_type value) noexcept {
+            attr_ = value;
+        }
+
         /*!
          * \brief clear
          */
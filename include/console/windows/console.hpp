@@ -13,7 +13,6 @@
 #include "buffer.hpp"
 #include "attribute.hpp"
 #include <algorithm>
-#include <map>
 #include <iostream>
 
 namespace xtd {
@@ -30,9 +29,14 @@ namespace xtd {
             mouse = MOUSE_EVENT,
             resize = WINDOW_BUFFER_SIZE_EVENT,
             menu = MENU_EVENT,
-            focus = FOCUS_EVENT
+            focus = FOCUS_EVENT,
+            // a KEY_EVENT releasing a key
+            key_up = 0x100
         };
 
+        // the key releases are reported, as key_up
+        static constexpr bool key_releases = true;
+
         // mouse buttons
         enum class button {
             none,
@@ -68,13 +72,24 @@ namespace xtd {
 
     private:
         handle_type h_;
+        // signaled by interrupt()
+        handle_type stop_;
 
     public:
         events(handle_type h) :
-            h_(h)
+            h_(h),
+            stop_(::CreateEvent(nullptr, TRUE, FALSE, nullptr))
         {
         }
-        ~events() {}
+
+        events(events const&) = delete;
+        events& operator=(events const&) = delete;
+
+        ~events() {
+            if (nullptr != stop_) {
+                ::CloseHandle(stop_);
+            }
+        }
 
         //
         operator handle_type() const noexcept {
@@ -111,7 +126,7 @@ namespace xtd {
 
             switch (ir.EventType) {
             case KEY_EVENT:
-                e.type = kind::key;
+                e.type = ir.Event.KeyEvent.bKeyDown ? kind::key : kind::key_up;
                 e.key = ir.Event.KeyEvent.uChar.AsciiChar;
                 break;
 
@@ -140,10 +155,38 @@ namespace xtd {
                 break;
             }
 
-            ::FlushConsoleInputBuffer(h_);
             return e;
         }
 
+        /*!
+         * \brief waits for input, without reading it
+         * \param tm milliseconds
+         *      > 0 timeout
+         *      = 0 does not wait
+         *      < 0 until there is input
+         * \return true if there is input, false after interrupt()
+         */
+        bool wait(int tm) const noexcept {
+            DWORD ms = (tm < 0) ? INFINITE : static_cast<DWORD>(tm);
+            if (nullptr == stop_) {
+                return WAIT_OBJECT_0 == ::WaitForSingleObject(h_, ms) && count() > 0;
+            }
+
+            // the lowest index signaled is returned, stop_ first
+            HANDLE handles[2] = { stop_, h_ };
+            return WAIT_OBJECT_0 + 1 == ::WaitForMultipleObjects(2, handles, FALSE, ms) && count() > 0;
+        }
+
+        /*!
+         * \brief makes the current and the next wait() return false at once
+         *        (thread safe)
+         */
+        void interrupt() noexcept {
+            if (nullptr != stop_) {
+                ::SetEvent(stop_);
+            }
+        }
+
     private:
         /*!
          * \brief Retrieves the number of unread input records in the
@@ -186,6 +229,9 @@ namespace xtd {
             right
         };
 
+        // the attributes are the keys 0 .. max_attr - 1
+        static constexpr int max_attr = 256;
+
 
     private:
         using underlying_type = T;
@@ -196,15 +242,14 @@ namespace xtd {
         }
 
     protected:
-        struct color_pair {
-            color color_;
-            color background_;
-        };
-
-        std::map<int, color_pair> colors_;
+        // console attribute of each key, resolved once by add_attr()
+        attr::value_type attrs_[max_attr];
 
     public:
         screen_base() {
+            for (auto& a : attrs_) {
+                a = attr().get_attr();
+            }
         }
 
         virtual ~screen_base() {
@@ -248,7 +293,8 @@ namespace xtd {
             color bcolor = color::black
             )
         {
-            colors_[id] = color_pair{fcolor, bcolor};
+            assert(id >= 0 && id < max_attr);
+            attrs_[id] = attr(fcolor, bcolor).get_attr();
         }
 
         void set_mode(
@@ -589,15 +635,11 @@ namespace xtd {
 
         ///
         /// \brief set_attr
-        /// \param color
-        /// \param bcolor
+        /// \param id attribute added by add_attr()
         ///
         void set_attr(int id) {
-            auto it = base_type::colors_.find(id);
-            if (base_type::colors_.end() != it) {
-                buff_.set_color((*it).second.color_);
-                buff_.set_background((*it).second.background_);
-            }
+            assert(id >= 0 && id < base_type::max_attr);
+            buff_.set_attr(base_type::attrs_[id]);
         }
 
         /*!
@@ -693,6 +735,8 @@ namespace xtd {
         using base_type = T;
 
     public:
+        using events_type = events;
+
         console(coord_type size) :
             base_type(size)
         {
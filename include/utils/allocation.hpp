@@ -0,0 +1,43 @@
+
+/*!
+ * \brief
+ * \file  allocation.hpp
+ */
+
+#if !defined(ALLOCATION_H__)
+#define ALLOCATION_H__
+
+//
+#include <atomic>
+#include <cstddef>
+
+
+namespace xtd {
+
+    ///
+    /// \brief counts the heap allocations made by the program (debug builds
+    ///        only, in release builds the count is always 0)
+    ///
+    /// \note
+    /// The counting replaces the global operator new/delete, defined in
+    /// allocation.cpp: only a program built with it counts.
+    ///
+    struct allocations {
+        using counter_type = std::atomic<std::size_t>;
+
+        ///
+        /// \brief the number of allocations made since the program started
+        ///
+        static std::size_t count() noexcept {
+            return counter().load(std::memory_order_relaxed);
+        }
+
+        static counter_type& counter() noexcept {
+            static counter_type count_(0);
+            return count_;
+        }
+    };
+
+} // namespace xtd
+
+#endif // ALLOCATION_H__
@@ -0,0 +1,63 @@
+
+/*!
+ * \brief
+ * \file  bits.hpp
+ */
+
+#if !defined(BITS_H__)
+#define BITS_H__
+
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace xtd {
+
+    /*!
+     * \brief index of the lowest set bit of x (x != 0)
+     */
+    inline int lowest_bit(std::uint64_t x) noexcept {
+#if defined(_MSC_VER) && defined(_M_IX86)
+        // no 64 bit scan on x86, the two halves
+        unsigned long i;
+        if (0 != static_cast<std::uint32_t>(x)) {
+            _BitScanForward(&i, static_cast<std::uint32_t>(x));
+            return static_cast<int>(i);
+        }
+        _BitScanForward(&i, static_cast<std::uint32_t>(x >> 32));
+        return static_cast<int>(i) + 32;
+#elif defined(_MSC_VER)
+        unsigned long i;
+        _BitScanForward64(&i, x);
+        return static_cast<int>(i);
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
+    /*!
+     * \brief index of the highest set bit of x (x != 0)
+     */
+    inline int highest_bit(std::uint64_t x) noexcept {
+#if defined(_MSC_VER) && defined(_M_IX86)
+        // no 64 bit scan on x86, the two halves
+        unsigned long i;
+        if (0 != static_cast<std::uint32_t>(x >> 32)) {
+            _BitScanReverse(&i, static_cast<std::uint32_t>(x >> 32));
+            return static_cast<int>(i) + 32;
+        }
+        _BitScanReverse(&i, static_cast<std::uint32_t>(x));
+        return static_cast<int>(i);
+#elif defined(_MSC_VER)
+        unsigned long i;
+        _BitScanReverse64(&i, x);
+        return static_cast<int>(i);
+#else
+        return 63 - __builtin_clzll(x);
+#endif
+    }
+
+} // namespace xtd
+
+#endif // BITS_H__
@@ -9,41 +9,203 @@
 
 ///
 #include <random>
+#include <cstdint>
 
 
 namespace xtd {
 
+    /*!
+     * \brief splitmix64 generator, only used to expand a 64 bit seed
+     *        into the state of the main generator
+     */
+    struct splitmix64 {
+    private:
+        std::uint64_t state_;
+
+    public:
+        explicit splitmix64(std::uint64_t seed) noexcept :
+            state_(seed)
+        {
+        }
+
+        std::uint64_t next() noexcept {
+            std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+    };
+
+    /*!
+     * \brief xoshiro256** generator (32 bytes of state)
+     */
+    struct xoshiro256 {
+        using result_type = std::uint64_t;
+
+    private:
+        std::uint64_t s_[4];
+
+        static std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        explicit xoshiro256(std::uint64_t seed) noexcept {
+            splitmix64 sm(seed);
+            for (auto& s : s_) {
+                s = sm.next();
+            }
+        }
+
+        static constexpr result_type min() noexcept {
+            return 0;
+        }
+
+        static constexpr result_type max() noexcept {
+            return ~result_type(0);
+        }
+
+        result_type operator()() noexcept {
+            const std::uint64_t result = rotl(s_[1] * 5, 7) * 9;
+            const std::uint64_t t = s_[1] << 17;
+
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= t;
+            s_[3] = rotl(s_[3], 45);
+
+            return result;
+        }
+
+        /*!
+         * \brief advances the generator by 2^128 steps, i.e. the start of
+         *        the next non overlapping sub-sequence
+         */
+        void jump() noexcept {
+            static const std::uint64_t table[] = {
+                0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+            };
+
+            std::uint64_t s[4] = { 0, 0, 0, 0 };
+            for (auto j : table) {
+                for (auto b = 0; b < 64; ++b) {
+                    if (j & (std::uint64_t(1) << b)) {
+                        for (auto i = 0; i < 4; ++i) {
+                            s[i] ^= s_[i];
+                        }
+                    }
+                    (*this)();
+                }
+            }
+
+            for (auto i = 0; i < 4; ++i) {
+                s_[i] = s[i];
+            }
+        }
+    };
+
+    /*!
+     * \brief seed of the stream number index derived from a base seed
+     *        (e.g. one game out of a batch seeded with seed); the result only
+     *        depends on (seed, index)
+     */
+    inline std::uint64_t stream_seed(std::uint64_t seed, std::uint64_t index) noexcept {
+        return splitmix64(seed ^ splitmix64(index).next()).next();
+    }
+
     /*!
      * \brief integers random generator class
+     *
+     * \note
+     * The values are computed by this class (not by std::uniform_int_distribution),
+     * so a seed gives the same sequence with every compiler and standard library.
+     * The range (end - begin + 1) must fit in 32 bits.
      */
     template <typename T>
     struct random {
         using value_type = T;
+        using engine_type = xoshiro256;
 
     private:
-        std::random_device rdev_;
-        std::mt19937 rng_;
-//        std::default_random_engine rng_;
-        std::uniform_int_distribution<value_type> dist_;
+        engine_type rng_;
+        value_type begin_;
+        std::uint32_t range_;
+
+        random(engine_type const& rng, value_type begin, std::uint32_t range) noexcept :
+            rng_(rng),
+            begin_(begin),
+            range_(range)
+        {
+        }
 
     public:
         /*!
          * \brief random
-         * use the random_device (rdev_) once to seed the random number
+         * use a random_device once to seed the random number
          * generator (rng_)
          */
         random(value_type begin, value_type end) :
-            rng_(rdev_()),
-            dist_(begin, end)
+            random(begin, end, std::random_device()())
+        {
+        }
+
+        /*!
+         * \brief random
+         * explicit seed, the same seed always gives the same sequence
+         */
+        random(value_type begin, value_type end, std::uint64_t seed) noexcept :
+            rng_(seed),
+            begin_(begin),
+            range_(static_cast<std::uint32_t>(end - begin + 1))
         {
         }
 
         /*!
          * \brief feed
-         * \return
+         * \return the next value in [begin, end]
+         */
+        value_type seed() noexcept {
+            // Lemire's multiply and shift, with rejection of the biased values
+            std::uint32_t x = static_cast<std::uint32_t>(rng_() >> 32);
+            if (0 == range_) {
+                // the full 32 bits range
+                return static_cast<value_type>(begin_ + x);
+            }
+
+            std::uint64_t m = std::uint64_t(x) * range_;
+            std::uint32_t l = static_cast<std::uint32_t>(m);
+            if (l < range_) {
+                const std::uint32_t t = (0u - range_) % range_;
+                while (l < t) {
+                    x = static_cast<std::uint32_t>(rng_() >> 32);
+                    m = std::uint64_t(x) * range_;
+                    l = static_cast<std::uint32_t>(m);
+                }
+            }
+
+            return static_cast<value_type>(begin_ + static_cast<value_type>(m >> 32));
+        }
+
+        /*!
+         * \brief split
+         * \return a generator with the same range that continues this one's
+         *         sequence; this one jumps 2^128 values ahead, so the two
+         *         streams never overlap (e.g. one per worker thread)
+         */
+        random split() noexcept {
+            random child(rng_, begin_, range_);
+            rng_.jump();
+            return child;
+        }
+
+        /*!
+         * \brief advances the generator by 2^128 values
          */
-        value_type seed() {
-            return dist_(rng_);
+        void jump() noexcept {
+            rng_.jump();
         }
     };
 
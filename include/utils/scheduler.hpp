@@ -0,0 +1,151 @@
+
+/*!
+ * \brief
+ * \file  scheduler.hpp
+ */
+
+#if !defined(SCHEDULER_H__)
+#define SCHEDULER_H__
+
+#include <chrono>
+#include <cstdint>
+
+namespace xtd {
+
+    /*!
+     * \brief fixed timestep clock: turns the (monotonic) time into a number
+     *        of ticks of a fixed length, and limits the rate of the frames
+     *
+     * The time elapsed between two advance() calls is accumulated, and
+     * advance() returns the number of whole ticks in it; the remainder is
+     * kept for the next call. The simulation runs that many fixed steps, so
+     * everything counted in ticks (gravity, lock delay, auto repeat) is
+     * exact and the same whatever the times of the calls. The times can be
+     * given explicitly, e.g. to run without a real clock.
+     *
+     * The frames are independent of the ticks: frame_due() says whether a
+     * frame can be shown, at most one per frame length.
+     */
+    struct scheduler {
+        using clock_type = std::chrono::steady_clock;
+        using time_point = clock_type::time_point;
+        using duration = clock_type::duration;
+
+    private:
+        duration step_;
+        duration frame_;
+        std::uint32_t max_steps_;
+        time_point last_;           // time of the last advance()
+        duration accumulator_;      // time not turned into ticks yet
+        std::uint64_t ticks_;
+        time_point next_frame_;     // no frame before
+
+    public:
+        scheduler() = delete;
+
+        /*!
+         * \brief step the length of a tick, frame the shortest time between
+         *        two frames; at most max_steps ticks are returned by one
+         *        advance(), the rest of a longer delay is dropped (e.g.
+         *        after the process was stopped)
+         */
+        scheduler(duration step, duration frame, std::uint32_t max_steps = 1000) :
+            step_(step),
+            frame_(frame),
+            max_steps_(max_steps),
+            last_(),
+            accumulator_(duration::zero()),
+            ticks_(0),
+            next_frame_()
+        {
+        }
+
+        /*!
+         * \brief tick 0 and the first frame are now
+         */
+        void start(time_point now = clock_type::now()) noexcept {
+            last_ = now;
+            accumulator_ = duration::zero();
+            ticks_ = 0;
+            next_frame_ = now;
+        }
+
+        /*!
+         * \brief the time since the last advance() is not turned into ticks
+         *        (e.g. after a pause)
+         */
+        void resume(time_point now = clock_type::now()) noexcept {
+            last_ = now;
+        }
+
+        /*!
+         * \brief accumulates the time elapsed since the last call
+         * \return the number of ticks to run, ticks() is increased by it
+         */
+        std::uint32_t advance(time_point now = clock_type::now()) noexcept {
+            accumulator_ += now - last_;
+            last_ = now;
+
+            auto n = accumulator_ / step_;
+            if (n > max_steps_) {
+                n = max_steps_;
+                accumulator_ = duration::zero();
+            }
+            else {
+                accumulator_ -= n * step_;
+            }
+            ticks_ += n;
+
+            return static_cast<std::uint32_t>(n);
+        }
+
+        /*!
+         * \brief number of ticks run since start()
+         */
+        std::uint64_t ticks() const noexcept {
+            return ticks_;
+        }
+
+        /*!
+         * \brief the time the tick number t is (or was) due, e.g. to run the
+         *        events that happened before it first
+         */
+        time_point tick_time(std::uint64_t t) const noexcept {
+            auto ticks = static_cast<duration::rep>(t) - static_cast<duration::rep>(ticks_);
+            return last_ - accumulator_ + ticks * step_;
+        }
+
+        /*!
+         * \brief time left until advance() returns the tick number t
+         *        (zero if it is due)
+         */
+        duration until_tick(std::uint64_t t, time_point now = clock_type::now()) const noexcept {
+            duration left = tick_time(t) - now;
+            return (left > duration::zero()) ? left : duration::zero();
+        }
+
+        /*!
+         * \brief true if a frame can be shown now
+         */
+        bool frame_due(time_point now = clock_type::now()) const noexcept {
+            return now >= next_frame_;
+        }
+
+        /*!
+         * \brief a frame was shown, the next one is due a frame later
+         */
+        void frame_shown(time_point now = clock_type::now()) noexcept {
+            next_frame_ = now + frame_;
+        }
+
+        /*!
+         * \brief time left until a frame can be shown (zero if it is due)
+         */
+        duration until_frame(time_point now = clock_type::now()) const noexcept {
+            return (next_frame_ > now) ? next_frame_ - now : duration::zero();
+        }
+    };
+
+} // namespace xtd
+
+#endif // SCHEDULER_H__
@@ -19,8 +19,9 @@ namespace xtd {
     ///        i.e. between the start and stop point
     ///
     struct timer {
-        using high_resolution_clock = std::chrono::high_resolution_clock;
-        using time_point = std::chrono::time_point<high_resolution_clock>;
+        // monotonic, the measures do not jump when the wall clock is set
+        using clock_type = std::chrono::steady_clock;
+        using time_point = clock_type::time_point;
 
     private:
         time_point start_;
@@ -29,7 +30,7 @@ namespace xtd {
         /// \brief returns a time point representing the current point in time
         ///
         time_point now() const noexcept {
-           return high_resolution_clock::now();
+           return clock_type::now();
         }
 
     public:
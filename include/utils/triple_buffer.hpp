@@ -0,0 +1,91 @@
+
+/*!
+ * \brief
+ * \file  triple_buffer.hpp
+ */
+
+#if !defined(TRIPLE_BUFFER_H__)
+#define TRIPLE_BUFFER_H__
+
+#include <atomic>
+
+namespace xtd {
+
+    /*!
+     * \brief passes values from one writer thread to one reader thread,
+     *        without locks and without waiting
+     *
+     * The writer fills back() and publish()es it, the reader takes the
+     * newest published value with update() and reads it with front(). The
+     * values published while the reader was busy are skipped; neither side
+     * ever waits for the other one.
+     */
+    template <typename T>
+    struct triple_buffer {
+        using value_type = T;
+
+    private:
+        // the middle buffer holds a value not taken by the reader yet
+        static constexpr unsigned fresh = 4;
+        static constexpr unsigned index_mask = 3;
+
+        value_type buffers_[3];
+        alignas(64) std::atomic<unsigned> middle_;
+        alignas(64) unsigned back_;     // the writer's
+        alignas(64) unsigned front_;    // the reader's
+
+    public:
+        triple_buffer(triple_buffer const&) = delete;
+        triple_buffer& operator=(triple_buffer const&) = delete;
+
+        /*!
+         * \brief the three buffers are copies of value
+         */
+        explicit triple_buffer(value_type const& value) :
+            buffers_{ value, value, value },
+            middle_(1),
+            back_(0),
+            front_(2)
+        {
+        }
+
+        /*!
+         * \brief the buffer the writer fills
+         */
+        value_type& back() noexcept {
+            return buffers_[back_];
+        }
+
+        /*!
+         * \brief makes back() the newest value; back() is then another buffer
+         *        (writer only)
+         */
+        void publish() noexcept {
+            back_ = middle_.exchange(back_ | fresh, std::memory_order_acq_rel) & index_mask;
+        }
+
+        /*!
+         * \brief takes the newest published value, if there is one since the
+         *        last update() (reader only)
+         * \return true if front() changed
+         */
+        bool update() noexcept {
+            if (0 == (middle_.load(std::memory_order_relaxed) & fresh)) {
+                return false;
+            }
+
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & index_mask;
+            return true;
+        }
+
+        /*!
+         * \brief the value the reader uses
+         */
+        value_type const& front() const noexcept {
+            return buffers_[front_];
+        }
+    };
+
+} // namespace xtd
+
+#endif // TRIPLE_BUFFER_H__
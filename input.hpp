@@ -0,0 +1,180 @@
+
+/*!
+ * \file input.hpp
+ * \brief reads the console's events (on a thread of its own if the console
+ *        allows it) into a queue, each one with the time it was read
+ */
+
+#if !defined (_INPUT_H_)
+#define _INPUT_H_
+
+#include "../include/Queue.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+///
+/// \brief the events of a console, timestamped, in a lock-free queue
+///
+/// With a thread, the thread waits for the console's events and pushes them
+/// as soon as they are read, whatever the game loop is doing (e.g. drawing);
+/// wait() sleeps until there is one. Without a thread (a console whose input
+/// and output cannot be used by two threads), wait() waits for the console
+/// and reads its events, holding the console's lock if there is one. The
+/// lock is only tried: while another thread draws, the keys stay in the
+/// console until it is done, and wait() returns at its timeout anyway, so
+/// the caller never waits for the drawing.
+///
+/// An event is never dropped: if the queue is full the thread waits for the
+/// game loop, the terminal keeps the next keys meanwhile.
+///
+template <typename Events>
+struct input {
+    using events_type = Events;
+    using event_type = typename events_type::event_type;
+    using clock_type = std::chrono::steady_clock;
+    using time_point = clock_type::time_point;
+
+    ///
+    /// \brief an event and the time it was read
+    ///
+    struct stamped {
+        event_type event_;
+        time_point time_;
+    };
+
+    static constexpr std::size_t capacity = 256;
+    using queue_type = xtd::spsc_queue<stamped, capacity>;
+
+///
+/// \brief ev_ the console's events
+///         io_ the console's lock, taken to read without a thread (or nullptr)
+///         queue_ the events read and not popped yet
+///         wake_lock_, wake_ wake the consumer waiting in wait()
+///         threaded_ true if reader_ reads the events
+///         reader_ the thread reading the events (if any)
+///
+private:
+    events_type& ev_;
+    std::mutex* io_;
+    const bool threaded_;
+    queue_type queue_;
+    std::mutex wake_lock_;
+    std::condition_variable wake_;
+    std::thread reader_;
+
+public:
+    input() = delete;
+    input(input const&) = delete;
+    input& operator=(input const&) = delete;
+
+    input(events_type& ev, bool threaded, std::mutex* io = nullptr) :
+        ev_(ev),
+        io_(io),
+        threaded_(threaded)
+    {
+        if (threaded_) {
+            reader_ = std::thread([this]() { read_loop(); });
+        }
+    }
+
+    ~input() {
+        if (threaded_) {
+            ev_.interrupt();
+            reader_.join();
+        }
+    }
+
+    ///
+    /// \brief waits at most tm milliseconds (< 0 for ever) for an event
+    /// \return true if there are events to pop
+    ///
+    bool wait(int tm) {
+        if (!queue_.empty()) {
+            return true;
+        }
+
+        if (!threaded_) {
+            auto deadline = clock_type::now() + std::chrono::milliseconds(tm);
+            if (!ev_.wait(tm)) {
+                return false;
+            }
+
+            std::unique_lock<std::mutex> lock;
+            if (nullptr != io_) {
+                lock = std::unique_lock<std::mutex>(*io_, std::try_to_lock);
+                while (!lock.owns_lock()) {
+                    if (tm >= 0 && clock_type::now() >= deadline) {
+                        return false;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    lock.try_lock();
+                }
+            }
+            read_pending();
+            return !queue_.empty();
+        }
+
+        std::unique_lock<std::mutex> lock(wake_lock_);
+        auto ready = [this]() { return !queue_.empty(); };
+        if (tm < 0) {
+            wake_.wait(lock, ready);
+            return true;
+        }
+        return wake_.wait_for(lock, std::chrono::milliseconds(tm), ready);
+    }
+
+    ///
+    /// \brief the first event, without removing it
+    /// \return nullptr if there is none
+    ///
+    stamped const* peek() const noexcept {
+        return queue_.peek();
+    }
+
+    ///
+    /// \brief removes the first event into e
+    /// \return false if there is none
+    ///
+    bool pop(stamped& e) {
+        return queue_.pop(e);
+    }
+
+private:
+    ///
+    /// \brief reads every event the console has now into the queue
+    ///
+    void read_pending() {
+        do {
+            if (queue_.full()) {
+                if (!threaded_) {
+                    // popped by the caller first, the rest stays in the console
+                    return;
+                }
+                // the game loop pops them soon
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+
+            event_type e = ev_.read();
+            if (events_type::kind::none != e.type) {
+                queue_.push(stamped{ e, clock_type::now() });
+            }
+        } while (ev_.wait(0));
+    }
+
+    void read_loop() {
+        while (ev_.wait(-1)) {
+            read_pending();
+            {
+                // pushed before the lock: a consumer checking the queue
+                // under the lock cannot miss the notification
+                std::lock_guard<std::mutex> lock(wake_lock_);
+            }
+            wake_.notify_one();
+        }
+    }
+};
+
+#endif // _INPUT_H_
@@ -0,0 +1,206 @@
+
+/*!
+ * \file keymap.hpp
+ * \brief the actions bound to the keys, rebindable from a text file
+ */
+
+#if !defined (_KEYMAP_H_)
+#define _KEYMAP_H_
+
+#include "engine.h"
+#include <cstddef>
+#include <istream>
+#include <sstream>
+#include <string>
+
+///
+/// \brief table of the action of every key code, one lookup per key
+///
+/// The table has an entry for every character and for the curses (and ANSI
+/// console) codes of the arrow keys. The default bindings are the letters
+/// (both cases), space to drop, and the arrows.
+///
+/// load() reads bindings from lines "action key key ...", e.g.
+///
+///     # comment
+///     left a A left
+///     drop space
+///
+/// where a key is a character, or one of space, left, right, up, down. An
+/// action listed there loses its previous keys.
+///
+struct keymap {
+    // the arrow keys (the same codes as curses' KEY_*)
+    enum : int {
+        key_down = 0402,
+        key_up = 0403,
+        key_left = 0404,
+        key_right = 0405
+    };
+
+    // the key codes in the table are 0 .. size - 1
+    static constexpr std::size_t size = 512;
+
+private:
+    action actions_[size];
+
+public:
+    keymap() :
+        actions_()
+    {
+        bind('w', action::rotate);
+        bind('W', action::rotate);
+        bind(key_up, action::rotate);
+        bind('a', action::left);
+        bind('A', action::left);
+        bind(key_left, action::left);
+        bind('d', action::right);
+        bind('D', action::right);
+        bind(key_right, action::right);
+        bind('s', action::down);
+        bind('S', action::down);
+        bind(key_down, action::down);
+        bind(' ', action::drop);
+        bind('q', action::quit);
+        bind('Q', action::quit);
+        bind('p', action::pause);
+        bind('P', action::pause);
+        bind('i', action::stats);
+        bind('t', action::theme);
+    }
+
+    ///
+    /// \brief the action of the key (none if the key is not bound)
+    ///
+    action operator[](int key) const noexcept {
+        return (key >= 0 && key < static_cast<int>(size)) ? actions_[key] : action::none;
+    }
+
+    ///
+    /// \brief binds the key to the action (none unbinds it)
+    /// \return false if the key code is out of the table
+    ///
+    bool bind(int key, action a) noexcept {
+        if (key < 0 || key >= static_cast<int>(size)) {
+            return false;
+        }
+
+        actions_[key] = a;
+        return true;
+    }
+
+    ///
+    /// \brief reads bindings (see above); nothing changes if a line is not
+    ///         valid
+    /// \return false and the number of the line (from 1) which is not valid
+    ///
+    bool load(std::istream& in, std::size_t* bad_line = nullptr) {
+        keymap loaded(*this);
+        std::string line;
+        std::size_t number = 0;
+        while (std::getline(in, line)) {
+            ++number;
+            std::istringstream words(line);
+            std::string word;
+            if (!(words >> word) || '#' == word[0]) {
+                continue;
+            }
+
+            action a;
+            if (!parse_action(word, a)) {
+                return fail(number, bad_line);
+            }
+            loaded.unbind(a);
+            while (words >> word) {
+                int key;
+                if (!parse_key(word, key) || !loaded.bind(key, a)) {
+                    return fail(number, bad_line);
+                }
+            }
+        }
+
+        *this = loaded;
+        return true;
+    }
+
+    ///
+    /// \brief the name of the action in the files
+    ///
+    static char const* name(action a) noexcept {
+        switch (a) {
+        case action::rotate:
+            return "rotate";
+        case action::left:
+            return "left";
+        case action::right:
+            return "right";
+        case action::down:
+            return "down";
+        case action::drop:
+            return "drop";
+        case action::quit:
+            return "quit";
+        case action::pause:
+            return "pause";
+        case action::stats:
+            return "stats";
+        case action::theme:
+            return "theme";
+        default:
+            return "none";
+        }
+    }
+
+private:
+    void unbind(action a) noexcept {
+        for (auto& b : actions_) {
+            if (a == b) {
+                b = action::none;
+            }
+        }
+    }
+
+    static bool parse_action(std::string const& word, action& a) {
+        for (auto i = static_cast<int>(action::none); i <= static_cast<int>(action::theme); ++i) {
+            if (word == name(static_cast<action>(i))) {
+                a = static_cast<action>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool parse_key(std::string const& word, int& key) {
+        if (1 == word.size()) {
+            key = static_cast<unsigned char>(word[0]);
+        }
+        else if ("space" == word) {
+            key = ' ';
+        }
+        else if ("left" == word) {
+            key = key_left;
+        }
+        else if ("right" == word) {
+            key = key_right;
+        }
+        else if ("up" == word) {
+            key = key_up;
+        }
+        else if ("down" == word) {
+            key = key_down;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    static bool fail(std::size_t number, std::size_t* bad_line) noexcept {
+        if (nullptr != bad_line) {
+            *bad_line = number;
+        }
+        return false;
+    }
+};
+
+#endif // _KEYMAP_H_
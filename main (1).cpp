@@ -1,62 +1,315 @@
-#include "engine.h"
+#include "renderer.hpp"
+#include "snapshot.hpp"
+#include "console/console.hpp"
 #include "timer.hpp"
+#include "scheduler.hpp"
+#include "triple_buffer.hpp"
+#include "allocation.hpp"
+#include "input.hpp"
+#include "auto_shift.hpp"
+#include "keymap.hpp"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <cassert>
 
-int main() {
+#if defined(OS_LINUX) && defined(XTD_CONSOLE_ANSI)
+using console_type = xtd::ansi_console;
+// the input (stdin) and the output (stdout) can be used by two threads
+constexpr bool concurrent_io = true;
+#elif defined(OS_LINUX)
+using console_type = xtd::console;
+constexpr bool concurrent_io = false;
+#elif defined(OS_WIN)
+using console_type = xtd::console<xtd::screen_buffered<wchar_t>>;
+constexpr bool concurrent_io = false;
+#endif
+
+///
+/// usage: tetris [-t] [-d das] [-r arr] [-k keys]
+///     -t draws on a render thread, from snapshots of the game, so the game
+///        never waits for the terminal (with curses, which cannot read and
+///        draw at once, the keys pressed while drawing are read after it)
+///     -d milliseconds a left or right key is held before the block moves
+///        by itself (167)
+///     -r milliseconds between those moves, 0 moves to the wall at once (33)
+///     -k file of key bindings (see keymap.hpp)
+///
+/// keys: a, d, s, w (or the arrows), space move the block, p pauses, i shows
+///       the output statistics, t changes the colors, q quits
+///
+/// The loop sleeps until a key is pressed or the block has to fall, reads
+/// every pending key, then draws once if something changed. Nothing wakes
+/// it while the game is paused.
+///
+int main(int argc, char* argv[]) {
     using namespace xtd;
+    bool threaded = false;
+    int das = 167;
+    int arr = 33;
+    keymap bindings;
+    for (auto i = 1; i < argc; ++i) {
+        if (0 == std::strcmp(argv[i], "-t")) {
+            threaded = true;
+        }
+        else if (0 == std::strcmp(argv[i], "-d") && i + 1 < argc) {
+            das = std::atoi(argv[++i]);
+        }
+        else if (0 == std::strcmp(argv[i], "-r") && i + 1 < argc) {
+            arr = std::atoi(argv[++i]);
+        }
+        else if (0 == std::strcmp(argv[i], "-k") && i + 1 < argc) {
+            char const* file = argv[++i];
+            std::ifstream in(file);
+            std::size_t line = 0;
+            if (!in) {
+                std::fprintf(stderr, "%s: cannot be read\n", file);
+                return 1;
+            }
+            if (!bindings.load(in, &line)) {
+                std::fprintf(stderr, "%s:%zu: not an action and its keys\n", file, line);
+                return 1;
+            }
+        }
+    }
     const short_type width = 80;
     const short_type height = 30;
     coord_type size = make_coord(width, height);
     console_type con(size);
-    events& ev = con.get_events();
-    timer tmr;
+    using events_type = console_type::events_type;
+    events_type& ev = con.get_events();
+    renderer<console_type> view(con);
 
     #if defined(OS_WIN)
     con.set_size(size);
     con.set_window(size);
     #endif
-    con.add_attr(0, color::white, color::black);
-    con.add_attr(1, color::white, color::darkyellow);
-    con.add_attr(2, color::white, color::darkred);
-    con.add_attr(3, color::white, color::magenta);
-    con.add_attr(4, color::white, color::red);
-    con.add_attr(5, color::white, color::blue);
-    con.add_attr(6, color::white, color::darkgreen);
-    con.add_attr(7, color::white, color::darkcyan);
-    con.add_attr(8, color::white, color::darkgray);
     con.show_cursor(console_type::visibility::invisible);
 
-    engine eng(20, 12, 4, 4);
-    eng.draw(con);
-    tmr.start();
+    engine eng(20, 12);
+
+    // the view settings, changed by the keys and applied by the drawing thread
+    std::atomic<std::size_t> theme_index(0);
+    std::atomic<unsigned> stats_toggles(0);
+    std::size_t theme_shown = 0;
+    unsigned stats_shown = 0;
+    view.set_theme(themes[theme_shown]);
+
+    auto draw = [&](auto const& game) {
+        if (theme_index != theme_shown) {
+            theme_shown = theme_index;
+            view.set_theme(themes[theme_shown]);
+        }
+        for (; stats_shown != stats_toggles; ++stats_shown) {
+            view.toggle_stats();
+        }
+        view.draw(game);
+    };
+
+    // the snapshots drawn by the render thread, the newest one wins
+    triple_buffer<snapshot> frames{ snapshot(eng) };
+    std::atomic<bool> done(false);
+    // taken by both threads if the console's input and output are not independent
+    std::mutex io;
+    // wakes the render thread, which sleeps while there is nothing to draw
+    std::mutex wake_lock;
+    std::condition_variable wake;
+    bool pending = threaded;
+
+    std::thread render;
+    if (threaded) {
+        render = std::thread([&]() {
+            std::unique_lock<std::mutex> lock(io, std::defer_lock);
+            while (!done) {
+                {
+                    std::unique_lock<std::mutex> w(wake_lock);
+                    wake.wait(w, [&]() { return pending; });
+                    pending = false;
+                }
+                if (done) {
+                    break;
+                }
+
+                frames.update();
+                if (!concurrent_io) {
+                    lock.lock();
+                }
+                draw(frames.front());
+                if (!concurrent_io) {
+                    lock.unlock();
+                }
+            }
+        });
+    }
+    else {
+        draw(eng);
+    }
+
+    auto notify = [&]() {
+        {
+            std::lock_guard<std::mutex> w(wake_lock);
+            pending = true;
+        }
+        wake.notify_one();
+    };
+
+    auto show = [&]() {
+        if (!threaded) {
+            draw(eng);
+        }
+        else {
+            frames.back().assign(eng);
+            frames.publish();
+            notify();
+        }
+    };
+
+    // the game runs in ticks of a fixed length, the frames are at most max_fps
+    const int max_fps = 60;
+    scheduler clock(
+        std::chrono::duration_cast<scheduler::duration>(std::chrono::seconds(1)) / engine::tick_rate,
+        std::chrono::duration_cast<scheduler::duration>(std::chrono::seconds(1)) / max_fps);
+    // waits in whole milliseconds, rounded up so as not to wake before the time
+    auto to_timeout = [](scheduler::duration d) {
+        return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            d + std::chrono::milliseconds(1) - scheduler::duration(1)).count());
+    };
+
+    // the keys, read on a thread of their own if the console allows it
+    input<events_type> keys(ev, concurrent_io, (threaded && !concurrent_io) ? &io : nullptr);
+    bool paused = false;
+    // changed, but not shown yet
+    bool dirty = false;
+
+    // the left and right moves repeat on the game's clock; without key
+    // releases a key counts as held while the terminal repeats it
+    const int release = 100 * engine::tick_rate / 1000;
+    auto_shift shifter(
+        das * engine::tick_rate / 1000,
+        arr * engine::tick_rate / 1000,
+        events_type::key_releases ? 0 : release);
 
-    while (true) {
-        eng.handle_event(ev.read());
-        if (tmr.elapsed() > eng.speed()) {
-            tmr.stop();
-            events::event_type e;
-            e.type = events::kind::key;
-            // simulates downward movement
-            e.key = 's';
-            eng.handle_event(e);
+    auto handle = [&](events_type::event_type const& in) {
+        // key is only set by the key events
+        if (events_type::kind::key != in.type && events_type::kind::key_up != in.type) {
+            return;
+        }
+
+        action a = bindings[in.key];
+        if (events_type::kind::key_up == in.type) {
+            if (action::left == a) {
+                shifter.release(auto_shift::direction::left);
+            }
+            else if (action::right == a) {
+                shifter.release(auto_shift::direction::right);
+            }
+            return;
+        }
 
-            if (eng.game_over()) {
-                break;
+        switch (a) {
+        case action::stats:
+            // output statistics on/off
+            ++stats_toggles;
+            dirty = true;
+            break;
+        case action::theme:
+            // next color theme
+            theme_index = (theme_index + 1) % theme_count;
+            dirty = true;
+            break;
+        case action::pause:
+            paused = !paused;
+            if (!paused) {
+                // the time paused is not played
+                clock.resume();
+            }
+            break;
+        case action::quit:
+            eng.apply(a);
+            break;
+        case action::left:
+        case action::right:
+            if (!paused) {
+                shifter.press((action::left == a) ? auto_shift::direction::left : auto_shift::direction::right, eng);
             }
-            eng.draw(con);
-            tmr.start();
+            break;
+        default:
+            if (!paused) {
+                eng.apply(a);
+            }
+            break;
+        }
+    };
+
+    // handles the keys read before the time
+    auto handle_until = [&](scheduler::time_point t) {
+        input<events_type>::stamped e{};
+        for (auto p = keys.peek(); nullptr != p && p->time_ <= t; p = keys.peek()) {
+            keys.pop(e);
+            handle(e.event_);
         }
+    };
 
-        xtd::timer::sleep(std::chrono::milliseconds(50));
+    std::uint64_t revision = eng.revision();
+    clock.start();
+
+    while (!eng.game_over()) {
+        // until the game changes by itself, or for ever while paused; and
+        // until the next frame if one is waiting
+        int idle = std::min(eng.idle_ticks(), shifter.idle_ticks(eng));
+        int timeout = paused ? -1 : to_timeout(clock.until_tick(clock.ticks() + idle));
+        if (dirty) {
+            int frame = to_timeout(clock.until_frame());
+            timeout = (timeout < 0) ? frame : std::min(timeout, frame);
+        }
+        keys.wait(timeout);
+
+#if !defined(NDEBUG)
+        // the ticks and the keys must not allocate
+        auto allocs = xtd::allocations::count();
+#endif
+        if (!paused) {
+            // every key at its time: the ones pressed before a tick first
+            std::uint64_t first = clock.ticks();
+            std::uint64_t last = first + clock.advance();
+            for (auto t = first; t < last && !paused; ) {
+                handle_until(clock.tick_time(++t));
+                if (!paused) {
+                    shifter.tick(eng);
+                    eng.tick();
+                }
+            }
+        }
+        handle_until(scheduler::time_point::max());
+        assert(xtd::allocations::count() == allocs);
+
+        if (eng.revision() != revision) {
+            revision = eng.revision();
+            dirty = true;
+        }
+        if (dirty && clock.frame_due()) {
+            show();
+            clock.frame_shown();
+            dirty = false;
+        }
     }
 
-    con.set_attr(0);
-    con.move_cursor(make_coord(eng.board_width(), eng.board_height() / 2 ));
-    con.print(L"Game over!");
-    con.refresh();
+    done = true;
+    if (render.joinable()) {
+        notify();
+        render.join();
+    }
+
+    view.draw_game_over(eng);
 
     xtd::timer::sleep(std::chrono::milliseconds(5000));
 
     return 0;
 }
-
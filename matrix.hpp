@@ -4,27 +4,81 @@
 #include <iostream>
 #include <vector>
 
+///
+/// \brief non owning view of one matrix row (span like)
+///
+template <typename T>
+struct row_view {
+    using value_type = T;
+    using size_type = std::size_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+    using iterator = pointer;
+
+private:
+    pointer data_;
+    size_type size_;
+
+public:
+    row_view(pointer data, size_type size) noexcept :
+        data_(data),
+        size_(size)
+    {
+    }
+
+    ///
+    /// \brief a view of mutable elements converts to a view of const ones
+    ///
+    template <typename U>
+    row_view(row_view<U> const& rhs) noexcept :
+        data_(rhs.data()),
+        size_(rhs.size())
+    {
+    }
+
+    reference operator[] (size_type i) const noexcept {
+        return data_[i];
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    pointer data() const noexcept {
+        return data_;
+    }
+
+    iterator begin() const noexcept {
+        return data_;
+    }
+
+    iterator end() const noexcept {
+        return data_ + size_;
+    }
+};
+
+///
+/// \brief matrix stored in one contiguous buffer, row after row
+///
 template <typename T>
 struct matrix {
     using value_type = T;
     using size_type = std::size_t;
-    using line_type = std::vector<value_type>;
+    using line_type = row_view<value_type>;
+    using const_line_type = row_view<value_type const>;
 
 private:
-    std::vector<line_type> m_;
+    std::vector<value_type> m_;
     size_type rows_;
     size_type columns_;
 
 public:
     matrix() = delete;
     matrix(size_type rows, size_type columns) :
+        m_(rows * columns),
         rows_(rows),
         columns_(columns)
     {
-        m_.resize(rows_);
-        for (auto i = 0u; i < rows_; ++i) {
-            m_[i].resize(columns_);
-        }
     }
 
     matrix(matrix const&) = default;
@@ -45,12 +99,24 @@ public:
         return columns_;
     }
 
-    line_type& operator[] (size_type i) {
-        return m_[i];
+    ///
+    /// \brief pointer to the first element, rows are stored one after
+    ///        the other (row i starts at data() + i * columns())
+    ///
+    value_type* data() noexcept {
+        return m_.data();
+    }
+
+    value_type const* data() const noexcept {
+        return m_.data();
+    }
+
+    line_type operator[] (size_type i) {
+        return line_type(m_.data() + i * columns_, columns_);
     }
 
-    const line_type& operator[] (size_type i) const {
-        return m_[i];
+    const_line_type operator[] (size_type i) const {
+        return const_line_type(m_.data() + i * columns_, columns_);
     }
 
 };
@@ -67,4 +133,4 @@ std::ostream& operator<< (std::ostream& out, matrix<T> const& m) {
     return out;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,120 @@
+
+/*!
+ * \file palette.hpp
+ * \brief the attribute drawn for each cell state, and the color themes
+ *        that give the attributes their colors
+ */
+
+#if !defined (_PALETTE_H_)
+#define _PALETTE_H_
+
+#include "cell.h"
+#include "console/color.hpp"
+#include <cstddef>
+
+///
+/// \brief attribute ids of the cell states, indexed by state, plus the
+///         attribute of the text
+///
+struct palette {
+    static constexpr std::size_t states = static_cast<std::size_t>(state::Z) + 1;
+    // attribute of the text (score, messages)
+    static constexpr int text = 9;
+
+    int ids_[states];
+
+    constexpr int operator()(state s) const noexcept {
+        return ids_[static_cast<std::size_t>(s)];
+    }
+};
+
+///
+/// \brief empty 0, pieces I .. Z 1 .. 7, wall 8
+///
+constexpr palette cell_attributes = { { 0, 8, 1, 2, 3, 4, 5, 6, 7 } };
+
+static_assert(cell_attributes(state::empty) == 0, "the empty cells use the default attribute");
+static_assert(cell_attributes(state::wall) == 8, "the wall follows the pieces");
+
+///
+/// \brief colors of the cell states (indexed by state) and of the text
+///
+struct theme {
+    using color_type = xtd::color;
+
+    struct colors {
+        color_type fg_;
+        color_type bg_;
+    };
+
+    char const* name_;
+    colors cells_[palette::states];
+    colors text_;
+};
+
+///
+/// \brief the themes, the first one is the default
+///
+constexpr theme themes[] = {
+    {
+        "classic",
+        {
+            { xtd::color::white, xtd::color::black },       // empty
+            { xtd::color::white, xtd::color::darkgray },    // wall
+            { xtd::color::white, xtd::color::darkyellow },  // I
+            { xtd::color::white, xtd::color::darkred },     // O
+            { xtd::color::white, xtd::color::magenta },     // T
+            { xtd::color::white, xtd::color::red },         // L
+            { xtd::color::white, xtd::color::blue },        // J
+            { xtd::color::white, xtd::color::darkgreen },   // S
+            { xtd::color::white, xtd::color::darkcyan },    // Z
+        },
+        { xtd::color::white, xtd::color::darkred }
+    },
+    {
+        "guideline",
+        {
+            { xtd::color::white, xtd::color::black },
+            { xtd::color::white, xtd::color::gray },
+            { xtd::color::white, xtd::color::cyan },
+            { xtd::color::white, xtd::color::yellow },
+            { xtd::color::white, xtd::color::magenta },
+            { xtd::color::white, xtd::color::darkyellow },
+            { xtd::color::white, xtd::color::blue },
+            { xtd::color::white, xtd::color::green },
+            { xtd::color::white, xtd::color::red },
+        },
+        { xtd::color::black, xtd::color::white }
+    },
+    {
+        "mono",
+        {
+            { xtd::color::white, xtd::color::black },
+            { xtd::color::white, xtd::color::blue },
+            { xtd::color::black, xtd::color::white },
+            { xtd::color::black, xtd::color::white },
+            { xtd::color::black, xtd::color::white },
+            { xtd::color::black, xtd::color::white },
+            { xtd::color::black, xtd::color::white },
+            { xtd::color::black, xtd::color::white },
+            { xtd::color::black, xtd::color::white },
+        },
+        { xtd::color::white, xtd::color::black }
+    },
+};
+
+constexpr std::size_t theme_count = sizeof(themes) / sizeof(themes[0]);
+
+///
+/// \brief gives the attributes of the palette the colors of the theme,
+///         in one step
+///
+template <typename Console>
+void apply_theme(Console& con, theme const& t) {
+    for (auto s = 0u; s < palette::states; ++s) {
+        con.add_attr(cell_attributes.ids_[s], t.cells_[s].fg_, t.cells_[s].bg_);
+    }
+    con.add_attr(palette::text, t.text_.fg_, t.text_.bg_);
+}
+
+#endif // _PALETTE_H_
@@ -0,0 +1,202 @@
+
+/*!
+ * \file pieces.hpp
+ * \brief compile time table with the shape of every tetromino in each rotation
+ */
+
+#if !defined (_PIECES_H_)
+#define _PIECES_H_
+
+#include "cell.h"
+#include <cstdint>
+#include <cstddef>
+
+///
+/// \brief tetromino identifiers, in the order of their states (I .. Z)
+///
+enum class piece : unsigned char {
+    I,
+    O,
+    T,
+    L,
+    J,
+    S,
+    Z
+};
+
+///
+/// \brief shape of one tetromino in one rotation
+///         bits_ 4x4 cells, bit (y * 4 + x) set if the cell in row y and
+///             column x is not empty
+///         left_, top_, right_, bottom_ bounding box of the non empty cells
+///
+struct shape {
+    using bits_type = std::uint16_t;
+    using row_type = std::uint32_t;
+
+    bits_type bits_;
+    unsigned char left_;
+    unsigned char top_;
+    unsigned char right_;
+    unsigned char bottom_;
+
+    constexpr shape() :
+        bits_(0),
+        left_(0),
+        top_(0),
+        right_(0),
+        bottom_(0)
+    {
+    }
+
+    ///
+    /// \brief returns the occupancy mask of row y, bit x set if the cell
+    ///         in column x is not empty
+    ///
+    constexpr row_type row(std::size_t y) const noexcept {
+        return (bits_ >> (y * 4)) & 0xF;
+    }
+
+    constexpr bool test(std::size_t y, std::size_t x) const noexcept {
+        return 0 != (bits_ & (1u << (y * 4 + x)));
+    }
+};
+
+///
+/// \brief all the shapes, indexed by piece and rotation
+///
+struct piece_table {
+    static constexpr std::size_t count = 7;
+    static constexpr std::size_t rotations = 4;
+    static constexpr std::size_t size = 4;
+
+    shape shapes_[count][rotations];
+
+    constexpr piece_table() :
+        shapes_()
+    {
+    }
+
+    constexpr shape const& operator()(piece p, std::size_t rotation) const {
+        return shapes_[static_cast<std::size_t>(p)][rotation];
+    }
+};
+
+namespace detail {
+
+    ///
+    /// \brief the patterns, stored as strings, which give each tetromino its shape
+    ///
+    constexpr char const* patterns[piece_table::count] = {
+        "....IIII........",
+        ".....OO..OO.....",
+        "......T..TTT....",
+        ".....L...L...LL.",
+        "......J...J..JJ.",
+        ".....S...SS...S.",
+        "......Z..ZZ..Z.."
+    };
+
+    ///
+    /// \brief parses a pattern string into a shape
+    ///
+    constexpr shape parse(char const* pattern) {
+        shape s;
+        for (auto i = 0u; i < piece_table::size * piece_table::size; ++i) {
+            if (pattern[i] != '.') {
+                s.bits_ |= static_cast<shape::bits_type>(1u << i);
+            }
+        }
+        return s;
+    }
+
+    ///
+    /// \brief clockwise rotation, i.e. the cell in row y and column x
+    ///         takes the value of the cell in row (size - 1 - x) and column y
+    ///
+    constexpr shape rotate_right(shape const& s) {
+        constexpr auto n = piece_table::size;
+        shape r;
+        for (auto y = 0u; y < n; ++y) {
+            for (auto x = 0u; x < n; ++x) {
+                if (s.test(n - 1 - x, y)) {
+                    r.bits_ |= static_cast<shape::bits_type>(1u << (y * n + x));
+                }
+            }
+        }
+        return r;
+    }
+
+    ///
+    /// \brief computes the bounding box of the non empty cells
+    ///
+    constexpr shape bound(shape s) {
+        constexpr auto n = piece_table::size;
+        s.left_ = n - 1;
+        s.top_ = n - 1;
+        s.right_ = 0;
+        s.bottom_ = 0;
+        for (auto y = 0u; y < n; ++y) {
+            for (auto x = 0u; x < n; ++x) {
+                if (s.test(y, x)) {
+                    s.left_ = (x < s.left_) ? x : s.left_;
+                    s.top_ = (y < s.top_) ? y : s.top_;
+                    s.right_ = (x > s.right_) ? x : s.right_;
+                    s.bottom_ = (y > s.bottom_) ? y : s.bottom_;
+                }
+            }
+        }
+        return s;
+    }
+
+    constexpr piece_table make_table() {
+        piece_table t;
+        for (auto p = 0u; p < piece_table::count; ++p) {
+            shape s = parse(patterns[p]);
+            for (auto r = 0u; r < piece_table::rotations; ++r) {
+                t.shapes_[p][r] = bound(s);
+                s = rotate_right(s);
+            }
+        }
+        return t;
+    }
+
+    ///
+    /// \brief true if in every shape the cells of a row have no gap between
+    ///         them (a row is then stopped by its first cell in the direction
+    ///         it moves)
+    ///
+    constexpr bool contiguous_rows(piece_table const& t) {
+        for (auto p = 0u; p < piece_table::count; ++p) {
+            for (auto r = 0u; r < piece_table::rotations; ++r) {
+                for (auto y = 0u; y < piece_table::size; ++y) {
+                    auto m = t.shapes_[p][r].row(y);
+                    if (0 != m && 0 != (((m | (m - 1)) + 1) & m)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+} // namespace detail
+
+///
+/// \brief the table of all the shapes, generated at compile time
+///
+constexpr piece_table pieces = detail::make_table();
+
+static_assert(pieces(piece::I, 0).bits_ == 0x00F0, "I piece is horizontal in its spawn rotation");
+static_assert(pieces(piece::I, 1).bits_ == 0x4444, "I piece is vertical after one rotation");
+static_assert(pieces(piece::O, 1).bits_ == pieces(piece::O, 0).bits_, "O piece does not change when rotated");
+static_assert(detail::contiguous_rows(pieces), "the cells of a piece row are contiguous (see engine::reach)");
+
+///
+/// \brief returns the cell state used to color a piece
+///
+constexpr state piece_state(piece p) noexcept {
+    return static_cast<state>(static_cast<int>(state::I) + static_cast<int>(p));
+}
+
+#endif // _PIECES_H_
@@ -0,0 +1,209 @@
+
+/*!
+ * \file randomizer.hpp
+ * \brief generators of the sequence of pieces, with a preview queue
+ */
+
+#if !defined (_RANDOMIZER_H_)
+#define _RANDOMIZER_H_
+
+#include "pieces.hpp"
+#include "../include/Queue.h"
+#include "../include/utils/random.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+///
+/// \brief produces the pieces one batch (of piece_table::count pieces) at a time
+///         into a fixed capacity ring buffer; the pieces waiting in the buffer
+///         are the preview of what comes next
+///
+struct randomizer {
+    using size_type = std::size_t;
+
+    ///
+    /// \brief the generators
+    ///         uniform every piece is drawn independently
+    ///         bag     every batch is a random permutation of the 7 pieces
+    ///         history a piece that is one of the last 4 is re-drawn (a few times)
+    ///
+    enum class kind {
+        uniform,
+        bag,
+        history
+    };
+
+    static constexpr size_type batch = piece_table::count;
+    static constexpr size_type capacity = 2 * batch + 2;
+    // number of pieces that can always be previewed
+    static constexpr size_type preview_size = capacity - batch;
+
+    using queue_type = xtd::queue<piece, capacity>;
+
+///
+/// \brief kind_ the generator used to fill the queue
+///         rng_ draws a piece (uniform, history) or a permutation index (bag)
+///         queue_ the pieces generated but not used yet
+///         history_ the last pieces, used by the history generator
+///
+private:
+    kind kind_;
+    xtd::random<int> rng_;
+    queue_type queue_;
+    piece history_[4];
+
+public:
+    randomizer() = delete;
+    randomizer(kind k) :
+        kind_(k),
+        rng_(0, upper(k))
+    {
+        reset_history();
+        fill();
+    }
+
+    ///
+    /// \brief explicit seed, the same seed always gives the same sequence
+    ///
+    randomizer(kind k, std::uint64_t seed) :
+        kind_(k),
+        rng_(0, upper(k), seed)
+    {
+        reset_history();
+        fill();
+    }
+
+    kind type() const noexcept {
+        return kind_;
+    }
+
+    ///
+    /// \brief removes and returns the next piece
+    ///
+    piece next() {
+        piece p = queue_.pop();
+        fill();
+        return p;
+    }
+
+    ///
+    /// \brief returns the i-th upcoming piece without removing it
+    ///         (0 is the piece next() returns), i < preview_size
+    ///
+    piece peek(size_type i) const {
+        return queue_[i];
+    }
+
+    ///
+    /// \brief writes the next n pieces to out
+    ///
+    template <typename OutputIt>
+    OutputIt generate(OutputIt out, size_type n) {
+        for (; n > 0; --n) {
+            *out++ = next();
+        }
+        return out;
+    }
+
+    ///
+    /// \brief writes the next n pieces to the stream, one letter per piece
+    ///
+    void serialize(std::ostream& out, size_type n) {
+        char tmp[256];
+        while (n > 0) {
+            size_type count = (n < sizeof(tmp)) ? n : sizeof(tmp);
+            for (auto i = 0u; i < count; ++i) {
+                tmp[i] = to_char(next());
+            }
+            out.write(tmp, count);
+            n -= count;
+        }
+    }
+
+    ///
+    /// \brief the letter used for a piece in the serialized sequences
+    ///
+    static char to_char(piece p) noexcept {
+        return "IOTLJSZ"[static_cast<size_type>(p)];
+    }
+
+private:
+    static int upper(kind k) noexcept {
+        // bag draws the index of one of the 7! permutations
+        return (kind::bag == k) ? 5039 : static_cast<int>(piece_table::count) - 1;
+    }
+
+    void reset_history() noexcept {
+        history_[0] = piece::Z;
+        history_[1] = piece::S;
+        history_[2] = piece::Z;
+        history_[3] = piece::S;
+    }
+
+    ///
+    /// \brief generates whole batches while there is room for one
+    ///
+    void fill() {
+        while (queue_.size() + batch <= capacity) {
+            switch (kind_) {
+            case kind::bag:
+                fill_bag();
+                break;
+            case kind::history:
+                for (auto i = 0u; i < batch; ++i) {
+                    queue_.push(draw_history());
+                }
+                break;
+            case kind::uniform:
+            default:
+                for (auto i = 0u; i < batch; ++i) {
+                    queue_.push(static_cast<piece>(rng_.seed()));
+                }
+                break;
+            }
+        }
+    }
+
+    ///
+    /// \brief pushes one permutation of the 7 pieces, decoded from a single
+    ///         random index in [0, 7!) (factorial number system)
+    ///
+    void fill_bag() {
+        piece left[batch];
+        for (auto i = 0u; i < batch; ++i) {
+            left[i] = static_cast<piece>(i);
+        }
+
+        int index = rng_.seed();
+        for (auto n = batch; n > 0; --n) {
+            auto j = static_cast<size_type>(index) % n;
+            index /= static_cast<int>(n);
+            queue_.push(left[j]);
+            left[j] = left[n - 1];
+        }
+    }
+
+    ///
+    /// \brief draws a piece that is not one of the last 4, giving up after
+    ///         a few tries (so it is unlikely but not impossible)
+    ///
+    piece draw_history() {
+        piece p = piece::I;
+        for (auto roll = 0; roll < 6; ++roll) {
+            p = static_cast<piece>(rng_.seed());
+            if (p != history_[0] && p != history_[1] && p != history_[2] && p != history_[3]) {
+                break;
+            }
+        }
+
+        history_[3] = history_[2];
+        history_[2] = history_[1];
+        history_[1] = history_[0];
+        history_[0] = p;
+        return p;
+    }
+}; // struct randomizer
+
+#endif // _RANDOMIZER_H_
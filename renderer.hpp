@@ -0,0 +1,284 @@
+
+/*!
+ * \file renderer.hpp
+ * \brief draws the game (board, falling block and score) in the console
+ */
+
+#if !defined (_RENDERER_H_)
+#define _RENDERER_H_
+
+#include "engine.h"
+#include "matrix.hpp"
+#include "palette.hpp"
+#include "console/backend.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <type_traits>
+
+using namespace xtd;
+
+///
+/// \brief draws a game in a console backend (curses, ANSI, memory, tee ...,
+///         see is_console_backend); the game is an engine or a snapshot of
+///         one, both only expose read only access to their board, block,
+///         preview and score
+///
+/// The renderer composes each frame in memory (one attribute per board cell,
+/// every cell is two characters wide) and compares it with the frame it
+/// presented last: only the cells whose attribute changed are printed, and
+/// the console is refreshed once per frame.
+///
+template <typename Console>
+struct renderer {
+    using console_type = Console;
+    using char_type = typename console_type::char_type;
+    using frame_type = matrix<int>;
+
+    // number of upcoming pieces shown next to the board
+    static constexpr size_type preview_count = 3;
+
+    // attribute of a frame cell that is not known to be on the screen
+    enum : int { unknown = -1 };
+
+    static_assert(is_console_backend<console_type>::value, "renderer needs a console backend");
+
+///
+/// \brief con_ the console used for drawing
+///         frame_ the frame being composed
+///         shown_ the frame presented last
+///         score_ the score presented last
+///         stats_ the output statistics are shown (if the console counts them)
+///         stats_width_ the length of the statistics line shown
+///
+private:
+    console_type& con_;
+    frame_type frame_;
+    frame_type shown_;
+    int score_;
+    bool stats_;
+    int stats_width_;
+
+public:
+    renderer() = delete;
+    renderer(console_type& con) :
+        con_(con),
+        frame_(0, 0),
+        shown_(0, 0),
+        score_(unknown),
+        stats_(false),
+        stats_width_(0)
+    {
+    }
+
+    ///
+    /// \brief prints the board, block, preview and score in the console,
+    ///         only what changed since the previous frame
+    ///
+    template <typename Game>
+    void draw(Game const& eng) {
+        frame_scope<console_type> frame(con_);
+        compose(eng);
+        present(eng.get_board().origin());
+        if (eng.score() != score_) {
+            draw_score(eng);
+        }
+        draw_stats(eng, has_frame_stats<console_type>());
+        con_.refresh();
+    }
+
+    ///
+    /// \brief shows/hides the statistics of the console output below the
+    ///         score: bytes, escape sequences, cursor moves, attribute
+    ///         switches and refreshes of the previous frame
+    ///
+    void toggle_stats() noexcept {
+        stats_ = !stats_;
+    }
+
+    ///
+    /// \brief forgets the presented frame, so the next draw() prints everything
+    ///         (e.g. after the screen was cleared)
+    ///
+    void invalidate() {
+        std::fill(shown_.data(), shown_.data() + shown_.rows() * shown_.columns(), unknown);
+        score_ = unknown;
+    }
+
+    ///
+    /// \brief prints the game over message next to the board
+    ///
+    template <typename Game>
+    void draw_game_over(Game const& eng) {
+        con_.set_attr(attribute(state::empty));
+        con_.move_cursor(make_coord(eng.board_width(), eng.board_height() / 2));
+        print_text("Game over!");
+        con_.refresh();
+        // the message covers part of the board
+        invalidate();
+    }
+
+    ///
+    /// \brief gives the attributes the colors of the theme and draws
+    ///         everything again with them on the next draw()
+    ///
+    void set_theme(theme const& t) {
+        apply_theme(con_, t);
+        invalidate();
+    }
+
+    ///
+    /// \brief the attribute used to draw a cell in the given state
+    ///
+    static constexpr int attribute(state s) noexcept {
+        return cell_attributes(s);
+    }
+
+private:
+    ///
+    /// \brief builds the frame: the board, the falling block over it and
+    ///         the next pieces to the right of the board
+    ///
+    template <typename Game>
+    void compose(Game const& eng) {
+        board const& b = eng.get_board();
+        size_type rows = std::max<size_type>(b.height(), preview_count * 3);
+        size_type columns = b.width() + 1 + piece_table::size;
+        if (frame_.rows() != rows || frame_.columns() != columns) {
+            frame_ = frame_type(rows, columns);
+            shown_ = frame_type(rows, columns);
+            invalidate();
+        }
+        std::fill(frame_.data(), frame_.data() + rows * columns, 0);
+
+        for (auto y = 0u; y < b.height(); ++y) {
+            // the runs are cached by the board until the row changes
+            auto dst = frame_[y].begin();
+            for (auto const& r : b.runs(y)) {
+                dst = std::fill_n(dst, r.length_, attribute(r.state_));
+            }
+        }
+
+        block const& blk = eng.get_block();
+        overlay(blk.get_shape(), blk.kind(), blk.position(), b.width(), b.height());
+
+        for (auto i = 0u; i < preview_count; ++i) {
+            piece p = eng.preview(i);
+            shape const& s = pieces(p, 0);
+            coord_type pos = make_coord(b.width() + 1 - s.left_, i * 3 - s.top_);
+            overlay(s, piece_state(p), pos, columns, rows);
+        }
+    }
+
+    ///
+    /// \brief draws the shape at pos in the frame, clipped to width x height
+    ///
+    void overlay(shape const& s, state kind, coord_type pos, size_type width, size_type height) {
+        for (auto y = s.top_; y <= s.bottom_; ++y) {
+            int fy = pos.Y + y;
+            if (fy < 0 || fy >= static_cast<int>(height)) {
+                continue;
+            }
+            for (auto x = s.left_; x <= s.right_; ++x) {
+                int fx = pos.X + x;
+                if (s.test(y, x) && fx >= 0 && fx < static_cast<int>(width)) {
+                    frame_[fy][fx] = attribute(kind);
+                }
+            }
+        }
+    }
+
+    ///
+    /// \brief prints the cells that differ from the presented frame, then
+    ///         the composed frame becomes the presented one
+    ///
+    void present(coord_type orig) {
+        int attr = unknown;
+        coord_type cursor = make_coord(-1, -1);
+        for (auto y = 0u; y < frame_.rows(); ++y) {
+            auto now = frame_[y];
+            auto before = shown_[y];
+            for (auto x = 0u; x < frame_.columns(); ++x) {
+                if (now[x] == before[x]) {
+                    continue;
+                }
+
+                if (now[x] != attr) {
+                    attr = now[x];
+                    con_.set_attr(attr);
+                }
+
+                coord_type pos = make_coord(orig.X + x * 2, orig.Y + y);
+                if (pos.X != cursor.X || pos.Y != cursor.Y) {
+                    con_.move_cursor(pos);
+                }
+                con_.print(' ');
+                con_.print(' ');
+                cursor = make_coord(pos.X + 2, pos.Y);
+            }
+        }
+
+        std::swap(frame_, shown_);
+    }
+
+    ///
+    /// \brief prints score in the console
+    ///
+    template <typename Game>
+    void draw_score(Game const& eng) {
+        con_.set_attr(palette::text);
+        con_.move_cursor(make_coord(2, eng.board_height() + 1));
+        print_text("Score: ");
+        // transforms integers to text for print
+        char tmp[32];
+        std::snprintf(tmp, sizeof(tmp), "%d", eng.score());
+        print_text(tmp);
+        score_ = eng.score();
+    }
+
+    ///
+    /// \brief prints the statistics line, or erases it once hidden
+    ///
+    template <typename Game>
+    void draw_stats(Game const& eng, std::true_type) {
+        char tmp[96];
+        int length = 0;
+        if (stats_) {
+            frame_stats const& s = con_.stats();
+            length = std::snprintf(tmp, sizeof(tmp), "%zu bytes %zu esc %zu moves %zu attr %zu refresh",
+                s.bytes, s.escapes, s.moves, s.attributes, s.refreshes);
+        }
+        if (0 == length && 0 == stats_width_) {
+            return;
+        }
+
+        // spaces over the end of the previous line
+        for (; length < stats_width_ && length < static_cast<int>(sizeof(tmp)) - 1; ++length) {
+            tmp[length] = ' ';
+        }
+        tmp[length] = '\0';
+
+        con_.set_attr(attribute(state::empty));
+        con_.move_cursor(make_coord(2, eng.board_height() + 2));
+        print_text(tmp);
+        stats_width_ = stats_ ? length : 0;
+    }
+
+    template <typename Game>
+    void draw_stats(Game const&, std::false_type) noexcept {
+    }
+
+    ///
+    /// \brief prints an ASCII string whatever the console's character type
+    ///
+    void print_text(char const* str) {
+        char_type tmp[64];
+        auto i = 0u;
+        for (; str[i] != '\0' && i < sizeof(tmp) / sizeof(tmp[0]) - 1; ++i) {
+            tmp[i] = static_cast<char_type>(str[i]);
+        }
+        tmp[i] = 0;
+        con_.print(tmp);
+    }
+}; // struct renderer
+
+#endif // _RENDERER_H_
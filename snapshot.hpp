@@ -0,0 +1,104 @@
+
+/*!
+ * \file snapshot.hpp
+ * \brief copy of what is drawn of a game (board, block, preview, score)
+ */
+
+#if !defined (_SNAPSHOT_H_)
+#define _SNAPSHOT_H_
+
+#include "engine.h"
+#include <cstdint>
+
+///
+/// \brief copy of an engine's board, block, preview and score at one moment,
+///         with the engine's read only accessors, so it can be drawn (e.g. on
+///         another thread) while the engine goes on
+///
+struct snapshot {
+    static constexpr size_type preview_size = randomizer::preview_size;
+
+///
+/// \brief board_, block_ copies of the engine's
+///         preview_ the next pieces
+///         revision_ the engine's revision when copied
+///
+private:
+    board board_;
+    block block_;
+    piece preview_[preview_size];
+    int score_;
+    int speed_;
+    size_type pieces_;
+    size_type lines_;
+    std::uint64_t revision_;
+
+public:
+    snapshot() = delete;
+
+    explicit snapshot(engine const& eng) :
+        board_(eng.get_board()),
+        block_(eng.get_block())
+    {
+        assign(eng);
+    }
+
+    ///
+    /// \brief copies the engine; a snapshot of a game of the same size does
+    ///         not allocate
+    ///
+    void assign(engine const& eng) {
+        board_ = eng.get_board();
+        block_ = eng.get_block();
+        for (auto i = 0u; i < preview_size; ++i) {
+            preview_[i] = eng.preview(i);
+        }
+        score_ = eng.score();
+        speed_ = eng.speed();
+        pieces_ = eng.piece_count();
+        lines_ = eng.line_count();
+        revision_ = eng.revision();
+    }
+
+    size_type board_width() const noexcept {
+        return board_.width();
+    }
+
+    size_type board_height() const noexcept {
+        return board_.height();
+    }
+
+    int score() const noexcept {
+        return score_;
+    }
+
+    int speed() const noexcept {
+        return speed_;
+    }
+
+    piece preview(size_type i) const noexcept {
+        return preview_[i];
+    }
+
+    size_type piece_count() const noexcept {
+        return pieces_;
+    }
+
+    size_type line_count() const noexcept {
+        return lines_;
+    }
+
+    std::uint64_t revision() const noexcept {
+        return revision_;
+    }
+
+    board const& get_board() const noexcept {
+        return board_;
+    }
+
+    block const& get_block() const noexcept {
+        return block_;
+    }
+}; // struct snapshot
+
+#endif // _SNAPSHOT_H_
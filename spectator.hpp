@@ -0,0 +1,243 @@
+
+/*!
+ * \file spectator.hpp
+ * \brief draws many games at once, each one downsampled in a tile
+ */
+
+#if !defined (_SPECTATOR_H_)
+#define _SPECTATOR_H_
+
+#include "engine.h"
+#include "palette.hpp"
+#include "console/backend.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+///
+/// \brief draws a grid of tiles, one game per tile, in a console backend
+///
+/// A tile shows the board with one character per column and two rows per
+/// character (the character has the color of the lower cell if it is not
+/// empty, else the color of the upper one), then a line with the game's
+/// number and score. A tile is drawn only if its game's revision changed,
+/// and only the characters that differ from the ones on screen are printed.
+/// draw() handles at most budget tiles per call (the next call continues
+/// with the following ones), so a frame costs the same whatever the number
+/// of games.
+///
+template <typename Console>
+struct spectator {
+    using console_type = Console;
+    using char_type = typename console_type::char_type;
+    using size_type = std::size_t;
+
+    static_assert(is_console_backend<console_type>::value, "spectator needs a console backend");
+
+private:
+    // attribute of a character not known to be on the screen
+    enum : int { unknown = -1 };
+
+    ///
+    /// \brief eng_ the game shown
+    ///         revision_ the game's revision when the tile was drawn
+    ///         score_ the score shown
+    ///         shown_ the characters' attributes shown, row after row
+    ///         dirty_ to be drawn whatever the revision
+    ///
+    struct tile {
+        engine const* eng_;
+        std::uint64_t revision_;
+        int score_;
+        std::vector<int> shown_;
+        bool dirty_;
+    };
+
+///
+/// \brief con_ the console used for drawing
+///         orig_ position of the first tile
+///         columns_ number of tiles in a row of tiles
+///         budget_ maximum number of tiles drawn by one draw()
+///         next_ first tile considered by the next draw()
+///         tiles_ one per game
+///         cells_ scratch frame of a board (attribute per cell)
+///
+    console_type& con_;
+    coord_type orig_;
+    size_type columns_;
+    size_type budget_;
+    size_type next_;
+    std::vector<tile> tiles_;
+    std::vector<int> cells_;
+
+public:
+    spectator() = delete;
+    spectator(console_type& con, coord_type orig, size_type columns, size_type budget) :
+        con_(con),
+        orig_(orig),
+        columns_(columns > 0 ? columns : 1),
+        budget_(budget > 0 ? budget : 1),
+        next_(0)
+    {
+    }
+
+    ///
+    /// \brief adds a tile showing the game (which must outlive the spectator,
+    ///         or be replaced with watch(i, eng))
+    ///
+    void watch(engine const& eng) {
+        tiles_.push_back(tile{ &eng, 0, unknown, std::vector<int>(), true });
+        tiles_.back().shown_.assign(tile_columns(eng) * board_lines(eng), unknown);
+    }
+
+    ///
+    /// \brief tile i shows the game from now on (e.g. a new game in place of
+    ///         one that ended)
+    ///
+    void watch(size_type i, engine const& eng) {
+        tile& t = tiles_[i];
+        t.eng_ = &eng;
+        t.dirty_ = true;
+        t.score_ = unknown;
+        t.shown_.assign(tile_columns(eng) * board_lines(eng), unknown);
+    }
+
+    size_type size() const noexcept {
+        return tiles_.size();
+    }
+
+    ///
+    /// \brief forgets what is on the screen, every tile is drawn again
+    ///
+    void invalidate() {
+        for (auto& t : tiles_) {
+            t.dirty_ = true;
+            t.score_ = unknown;
+            std::fill(t.shown_.begin(), t.shown_.end(), unknown);
+        }
+    }
+
+    ///
+    /// \brief draws the tiles whose game changed, at most budget of them,
+    ///         and refreshes the console once
+    /// \return the number of tiles drawn
+    ///
+    size_type draw() {
+        frame_scope<console_type> frame(con_);
+        size_type drawn = 0;
+        size_type count = tiles_.size();
+        size_type i = 0;
+        for (; i < count && drawn < budget_; ++i) {
+            size_type index = (next_ + i) % count;
+            tile& t = tiles_[index];
+            if (t.dirty_ || t.revision_ != t.eng_->revision()) {
+                draw_tile(index, t);
+                ++drawn;
+            }
+        }
+        // the tiles not looked at come first next time
+        next_ = (count > 0) ? (next_ + i) % count : 0;
+
+        con_.refresh();
+        return drawn;
+    }
+
+    ///
+    /// \brief position of tile i in the console
+    ///
+    coord_type position(size_type i) const {
+        engine const& eng = *tiles_[i].eng_;
+        short_type w = static_cast<short_type>(tile_columns(eng) + 1);
+        short_type h = static_cast<short_type>(board_lines(eng) + 1);
+        return make_coord(orig_.X + (i % columns_) * w, orig_.Y + (i / columns_) * h);
+    }
+
+private:
+    static size_type tile_columns(engine const& eng) noexcept {
+        return eng.board_width();
+    }
+
+    static size_type board_lines(engine const& eng) noexcept {
+        return (eng.board_height() + 1) / 2;
+    }
+
+    ///
+    /// \brief draws one tile: the board and the block in half the rows, then
+    ///         the score
+    ///
+    void draw_tile(size_type index, tile& t) {
+        engine const& eng = *t.eng_;
+        board const& b = eng.get_board();
+        const size_type width = b.width();
+        const size_type height = b.height();
+
+        cells_.resize(width * height);
+        for (auto y = 0u; y < height; ++y) {
+            auto dst = cells_.begin() + y * width;
+            for (auto const& r : b.runs(y)) {
+                dst = std::fill_n(dst, r.length_, cell_attributes(r.state_));
+            }
+        }
+
+        block const& blk = eng.get_block();
+        shape const& s = blk.get_shape();
+        coord_type pos = blk.position();
+        for (auto y = s.top_; y <= s.bottom_; ++y) {
+            for (auto x = s.left_; x <= s.right_; ++x) {
+                int fx = pos.X + x;
+                int fy = pos.Y + y;
+                if (s.test(y, x) && fx >= 0 && fx < static_cast<int>(width) && fy >= 0 && fy < static_cast<int>(height)) {
+                    cells_[fy * width + fx] = cell_attributes(blk.kind());
+                }
+            }
+        }
+
+        const int empty = cell_attributes(state::empty);
+        coord_type orig = position(index);
+        int attr = unknown;
+        coord_type cursor = make_coord(-1, -1);
+        for (auto line = 0u; line < board_lines(eng); ++line) {
+            for (auto x = 0u; x < width; ++x) {
+                int upper = cells_[2 * line * width + x];
+                int lower = (2 * line + 1 < height) ? cells_[(2 * line + 1) * width + x] : empty;
+                int now = (lower != empty) ? lower : upper;
+
+                int& before = t.shown_[line * width + x];
+                if (now == before) {
+                    continue;
+                }
+                before = now;
+
+                if (now != attr) {
+                    attr = now;
+                    con_.set_attr(attr);
+                }
+
+                coord_type p = make_coord(orig.X + x, orig.Y + line);
+                if (p.X != cursor.X || p.Y != cursor.Y) {
+                    con_.move_cursor(p);
+                }
+                con_.print(' ');
+                cursor = make_coord(p.X + 1, p.Y);
+            }
+        }
+
+        if (eng.score() != t.score_) {
+            char tmp[32];
+            int length = std::snprintf(tmp, sizeof(tmp), "%u %d", static_cast<unsigned>(index), eng.score());
+            con_.set_attr(palette::text);
+            con_.move_cursor(make_coord(orig.X, orig.Y + board_lines(eng)));
+            // padded with spaces (or cut) to the width of the tile
+            for (auto i = 0; i < static_cast<int>(width); ++i) {
+                con_.print(static_cast<char_type>((i < length) ? tmp[i] : ' '));
+            }
+            t.score_ = eng.score();
+        }
+
+        t.revision_ = eng.revision();
+        t.dirty_ = false;
+    }
+};
+
+#endif // _SPECTATOR_H_
@@ -0,0 +1,246 @@
+
+/*!
+ * \file simulator.cpp
+ * \brief plays many games without a console, using a bot, and reports
+ *        the throughput and the score distribution
+ *
+ * build:  g++ -std=c++14 -O2 -pthread -I.. -I../include simulator.cpp -o simulator
+ * usage:  simulator [-n games] [-t threads] [-s seed] [-p greedy|random]
+ *                   [-g bag|uniform|history] [-m max pieces per game]
+ *                   [-r rows] [-c columns] [-d pieces]
+ *
+ * With -d the games are not played, instead the first pieces of every game
+ * are written to stdout, one game per line (e.g. to verify replays).
+ *
+ * Every game is seeded from (seed, game index) only, so the results do not
+ * depend on the number of threads.
+ */
+
+#include "engine.h"
+#include "bot.hpp"
+#include "utils/timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    ///
+    /// \brief command line options
+    ///
+    struct options {
+        std::size_t games = 1000;
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        std::uint64_t seed = 1;
+        bot::policy policy = bot::policy::greedy;
+        randomizer::kind generator = randomizer::kind::bag;
+        std::size_t dump = 0;
+        std::size_t max_pieces = 1000;
+        short_type rows = 20;
+        short_type columns = 12;
+    };
+
+    ///
+    /// \brief outcome of one game
+    ///
+    struct result {
+        int score;
+        std::uint32_t pieces;
+        std::uint32_t lines;
+    };
+
+    ///
+    /// \brief plays game number index until game over (or max_pieces)
+    ///
+    result play(options const& opt, std::size_t index) {
+        std::uint64_t seed = xtd::stream_seed(opt.seed, index);
+        engine eng(opt.rows, opt.columns, seed, opt.generator);
+        bot player(opt.policy, xtd::splitmix64(seed).next());
+
+        while (!eng.game_over() && eng.piece_count() < opt.max_pieces) {
+            player.play(eng);
+        }
+
+        return result{
+            eng.score(),
+            static_cast<std::uint32_t>(eng.piece_count()),
+            static_cast<std::uint32_t>(eng.line_count())
+        };
+    }
+
+    bool parse(int argc, char* argv[], options& opt) {
+        for (auto i = 1; i < argc; ++i) {
+            char const* arg = argv[i];
+            char const* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (nullptr == value || '-' != arg[0] || '\0' == arg[1] || '\0' != arg[2]) {
+                return false;
+            }
+
+            switch (arg[1]) {
+            case 'n':
+                opt.games = std::strtoull(value, nullptr, 10);
+                break;
+            case 't':
+                opt.threads = std::max(1ul, std::strtoul(value, nullptr, 10));
+                break;
+            case 's':
+                opt.seed = std::strtoull(value, nullptr, 10);
+                break;
+            case 'p':
+                if (0 == std::strcmp(value, "greedy")) {
+                    opt.policy = bot::policy::greedy;
+                }
+                else if (0 == std::strcmp(value, "random")) {
+                    opt.policy = bot::policy::random;
+                }
+                else {
+                    return false;
+                }
+                break;
+            case 'g':
+                if (0 == std::strcmp(value, "bag")) {
+                    opt.generator = randomizer::kind::bag;
+                }
+                else if (0 == std::strcmp(value, "uniform")) {
+                    opt.generator = randomizer::kind::uniform;
+                }
+                else if (0 == std::strcmp(value, "history")) {
+                    opt.generator = randomizer::kind::history;
+                }
+                else {
+                    return false;
+                }
+                break;
+            case 'd':
+                opt.dump = std::strtoull(value, nullptr, 10);
+                break;
+            case 'm':
+                opt.max_pieces = std::strtoull(value, nullptr, 10);
+                break;
+            case 'r':
+                opt.rows = static_cast<short_type>(std::atoi(value));
+                break;
+            case 'c':
+                opt.columns = static_cast<short_type>(std::atoi(value));
+                break;
+            default:
+                return false;
+            }
+            ++i;
+        }
+
+        // the columns count the two walls, narrower boards leave no room to
+        // place the pieces and every game ends before its first one
+        return opt.rows > 4 && opt.columns >= 8 && opt.columns <= static_cast<short_type>(board::max_width);
+    }
+
+    ///
+    /// \brief prints min, mean, percentiles and max of the values
+    ///
+    template <typename T>
+    void report(char const* name, std::vector<T>& values) {
+        if (values.empty()) {
+            return;
+        }
+
+        std::sort(values.begin(), values.end());
+        double sum = 0;
+        for (auto v : values) {
+            sum += v;
+        }
+        double mean = sum / values.size();
+        double var = 0;
+        for (auto v : values) {
+            var += (v - mean) * (v - mean);
+        }
+
+        auto at = [&values](double p) {
+            return static_cast<double>(values[static_cast<std::size_t>(p * (values.size() - 1))]);
+        };
+        std::printf(
+            "%-8s min %8.0f  mean %10.1f  sd %10.1f  p10 %8.0f  p50 %8.0f  p90 %8.0f  p99 %8.0f  max %8.0f\n",
+            name,
+            at(0), mean, std::sqrt(var / values.size()),
+            at(0.1), at(0.5), at(0.9), at(0.99), at(1)
+            );
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    options opt;
+    if (!parse(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [-n games] [-t threads] [-s seed] [-p greedy|random] [-g bag|uniform|history] [-m max pieces] [-r rows] [-c columns] [-d pieces]\n", argv[0]);
+        return 1;
+    }
+
+    if (opt.dump > 0) {
+        // the same seeds as the played games
+        for (auto g = 0u; g < opt.games; ++g) {
+            randomizer sequence(opt.generator, xtd::stream_seed(opt.seed, g));
+            sequence.serialize(std::cout, opt.dump);
+            std::cout.put('\n');
+        }
+        return 0;
+    }
+
+    std::vector<result> results(opt.games);
+    std::atomic<std::size_t> next(0);
+    const std::size_t chunk = 16;
+
+    xtd::timer tmr;
+    tmr.start();
+
+    std::vector<std::thread> workers;
+    for (auto i = 0u; i < opt.threads; ++i) {
+        workers.emplace_back([&]() {
+            for (;;) {
+                std::size_t first = next.fetch_add(chunk);
+                if (first >= opt.games) {
+                    break;
+                }
+
+                std::size_t last = std::min(first + chunk, opt.games);
+                for (auto g = first; g < last; ++g) {
+                    results[g] = play(opt, g);
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    double seconds = tmr.elapsed<std::chrono::microseconds>() / 1e6;
+
+    std::vector<int> scores;
+    std::vector<std::uint32_t> pieces_per_game;
+    std::vector<std::uint32_t> lines_per_game;
+    double pieces = 0;
+    double lines = 0;
+    for (auto const& r : results) {
+        scores.push_back(r.score);
+        pieces_per_game.push_back(r.pieces);
+        lines_per_game.push_back(r.lines);
+        pieces += r.pieces;
+        lines += r.lines;
+    }
+
+    std::printf("games %zu  threads %u  seed %llu  time %.3f s\n",
+        opt.games, opt.threads, static_cast<unsigned long long>(opt.seed), seconds);
+    std::printf("games/s %.1f  pieces/s %.1f  lines/s %.1f\n",
+        opt.games / seconds, pieces / seconds, lines / seconds);
+    report("score", scores);
+    report("pieces", pieces_per_game);
+    report("lines", lines_per_game);
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+
+/*!
+ * \file spectator.cpp
+ * \brief plays many games with bots and shows all of them on one screen
+ *
+ * build:  g++ -std=c++14 -O2 -I.. -I../include -I../include/utils spectator.cpp -o spectator -lncurses
+ *         (add -DXTD_CONSOLE_ANSI for the ANSI terminal console)
+ * usage:  spectator [-n games] [-s seed] [-p greedy|random] [-f frames per second]
+ *                   [-r pieces per second per game] [-b tiles per frame]
+ *                   [-k tiles per row] [-l rows] [-c columns]
+ *
+ * 'q' quits. A game that ends is replaced by a new one (with the next seed).
+ */
+
+#include "engine.h"
+#include "bot.hpp"
+#include "spectator.hpp"
+#include "console/console.hpp"
+#include "utils/timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(OS_LINUX) && defined(XTD_CONSOLE_ANSI)
+using console_type = xtd::ansi_console;
+#elif defined(OS_LINUX)
+using console_type = xtd::console;
+#elif defined(OS_WIN)
+using console_type = xtd::console<xtd::screen_buffered<wchar_t>>;
+#endif
+
+namespace {
+
+    ///
+    /// \brief command line options
+    ///
+    struct options {
+        std::size_t games = 16;
+        std::uint64_t seed = 1;
+        bot::policy policy = bot::policy::greedy;
+        int fps = 10;
+        double rate = 4;
+        std::size_t budget = 16;
+        std::size_t per_row = 0;
+        short_type rows = 20;
+        short_type columns = 12;
+    };
+
+    bool parse(int argc, char* argv[], options& opt) {
+        for (auto i = 1; i < argc; ++i) {
+            char const* arg = argv[i];
+            char const* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (nullptr == value || '-' != arg[0] || '\0' == arg[1] || '\0' != arg[2]) {
+                return false;
+            }
+
+            switch (arg[1]) {
+            case 'n':
+                opt.games = std::strtoull(value, nullptr, 10);
+                break;
+            case 's':
+                opt.seed = std::strtoull(value, nullptr, 10);
+                break;
+            case 'p':
+                if (0 == std::strcmp(value, "greedy")) {
+                    opt.policy = bot::policy::greedy;
+                }
+                else if (0 == std::strcmp(value, "random")) {
+                    opt.policy = bot::policy::random;
+                }
+                else {
+                    return false;
+                }
+                break;
+            case 'f':
+                opt.fps = std::max(1, std::atoi(value));
+                break;
+            case 'r':
+                opt.rate = std::atof(value);
+                break;
+            case 'b':
+                opt.budget = std::strtoull(value, nullptr, 10);
+                break;
+            case 'k':
+                opt.per_row = std::strtoull(value, nullptr, 10);
+                break;
+            case 'l':
+                opt.rows = static_cast<short_type>(std::atoi(value));
+                break;
+            case 'c':
+                opt.columns = static_cast<short_type>(std::atoi(value));
+                break;
+            default:
+                return false;
+            }
+            ++i;
+        }
+
+        return opt.games > 0 && opt.rows > 4 && opt.columns > 4 && opt.columns <= static_cast<short_type>(board::max_width);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    options opt;
+    if (!parse(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: %s [-n games] [-s seed] [-p greedy|random] [-f fps] [-r pieces/s] [-b tiles/frame] [-k tiles/row] [-l rows] [-c columns]\n", argv[0]);
+        return 1;
+    }
+
+    console_type con(make_coord(80, 30));
+    using events_type = console_type::events_type;
+    events_type& ev = con.get_events();
+    apply_theme(con, themes[0]);
+    con.show_cursor(console_type::visibility::invisible);
+
+    if (0 == opt.per_row) {
+        // as many tiles as fit in the console's width
+        rec_type w = con.window();
+        std::size_t width = static_cast<std::size_t>(w.Right - w.Left + 1);
+        opt.per_row = std::max<std::size_t>(1, width / (opt.columns + 1));
+    }
+
+    // reserved, the spectator keeps pointers to the games
+    std::vector<engine> games;
+    std::vector<bot> players;
+    games.reserve(opt.games);
+    players.reserve(opt.games);
+    std::uint64_t next_seed = 0;
+    for (auto i = 0u; i < opt.games; ++i, ++next_seed) {
+        std::uint64_t seed = xtd::stream_seed(opt.seed, next_seed);
+        games.emplace_back(opt.rows, opt.columns, seed);
+        players.emplace_back(opt.policy, xtd::splitmix64(seed).next());
+    }
+
+    spectator<console_type> view(con, make_coord(0, 0), opt.per_row, opt.budget);
+    for (auto const& g : games) {
+        view.watch(g);
+    }
+
+    const auto frame = std::chrono::microseconds(1000000 / opt.fps);
+    // pieces each game plays per frame, the fraction carried over
+    const double pieces_per_frame = opt.rate / opt.fps;
+    double pieces = 0;
+    auto deadline = std::chrono::steady_clock::now();
+
+    for (;;) {
+        events_type::event_type in = ev.read();
+        if (events_type::kind::key == in.type && ('q' == in.key || 'Q' == in.key)) {
+            break;
+        }
+
+        pieces += pieces_per_frame;
+        for (; pieces >= 1; pieces -= 1) {
+            for (auto i = 0u; i < games.size(); ++i) {
+                if (games[i].game_over()) {
+                    std::uint64_t seed = xtd::stream_seed(opt.seed, next_seed++);
+                    games[i] = engine(opt.rows, opt.columns, seed);
+                    players[i] = bot(opt.policy, xtd::splitmix64(seed).next());
+                    view.watch(i, games[i]);
+                }
+                players[i].play(games[i]);
+            }
+        }
+
+        view.draw();
+
+        deadline += frame;
+        auto now = std::chrono::steady_clock::now();
+        if (deadline > now) {
+            xtd::timer::sleep(std::chrono::duration_cast<std::chrono::microseconds>(deadline - now));
+        }
+        else {
+            // late, do not try to catch up
+            deadline = now;
+        }
+    }
+
+    return 0;
+}